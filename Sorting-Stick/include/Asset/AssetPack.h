@@ -0,0 +1,90 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Global/MappedFile.h"
+
+namespace Asset
+{
+	enum class PackedAssetType : std::uint32_t
+	{
+		TEXTURE,
+		FONT,
+		SOUND,
+	};
+
+	// An asset to put into the pack; textures wider than max_texture_width (if not 0) are scaled down to it.
+	struct PackSource
+	{
+		PackedAssetType type;
+		std::string path;
+		unsigned int max_texture_width;
+	};
+
+	// Table entry of the pack, stored as is (little endian). Textures are a rectangle of the atlas, fonts the font
+	// file and sounds 16 bit PCM, both at data_offset.
+	struct PackEntry
+	{
+		static const int max_path_length = 111;
+
+		std::uint32_t type;
+		char path[max_path_length + 1];
+		std::uint64_t data_offset;
+		std::uint64_t data_size;
+		std::uint32_t atlas_x;
+		std::uint32_t atlas_y;
+		std::uint32_t width;
+		std::uint32_t height;
+		std::uint32_t channel_count;
+		std::uint32_t sample_rate;
+	};
+
+	// Single memory mapped file holding every startup asset ready for use: all textures packed into one RGBA atlas
+	// that is uploaded in one go, font files and decoded sound samples. Nothing is decoded when it is opened.
+	class AssetPack
+	{
+	private:
+		struct PackHeader
+		{
+			std::uint32_t magic;
+			std::uint32_t version;
+			std::uint32_t atlas_width;
+			std::uint32_t atlas_height;
+			std::uint64_t atlas_offset;
+			std::uint32_t entry_count;
+			std::uint32_t reserved;
+		};
+
+		static const std::uint32_t pack_magic = 0x50415353; // "SSAP"
+		static const std::uint32_t pack_version = 1;
+		static const unsigned int atlas_width = 2048;
+		static const unsigned int atlas_padding = 2;    // keeps neighbours from bleeding in when scaled
+		static const std::size_t data_alignment = 16;
+
+		Global::MappedFile file;
+		const PackHeader* header;
+		const PackEntry* entries;
+
+		bool validate();
+
+		static bool packAtlas(const std::vector<sf::Image>& images, std::vector<sf::Vector2u>& positions, unsigned int& atlas_height);
+		static sf::Image scaleToWidth(const sf::Image& image, unsigned int width);
+		static std::size_t align(std::size_t offset);
+
+	public:
+		AssetPack();
+
+		bool open(const std::string& path);
+		void close();
+		bool isOpen() const;
+
+		const PackEntry* findEntry(const std::string& path, PackedAssetType type) const;
+		const std::uint8_t* getData(const PackEntry& entry) const;
+		const std::uint8_t* getAtlasPixels() const;
+		sf::Vector2u getAtlasSize() const;
+
+		// The build step: decodes every source and writes the pack, false if any of them could not be read.
+		static bool build(const std::vector<PackSource>& sources, const std::string& path);
+	};
+}
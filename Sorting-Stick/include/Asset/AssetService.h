@@ -0,0 +1,149 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <SFML/Audio.hpp>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Task/TaskService.h"
+#include "Asset/AssetPack.h"
+
+namespace Asset
+{
+	// Part of a texture to draw; everything from the asset pack shares the atlas.
+	struct TextureRegion
+	{
+		const sf::Texture* texture;
+		sf::IntRect rect;
+	};
+
+	// Loads every texture, font and sound once per path. Assets in the asset pack are ready as soon as it is mapped,
+	// anything else is read and decoded on the task pool and the GPU or OpenAL objects are created from the result on
+	// the main thread in update(), so the window keeps drawing while the rest of the assets arrive.
+	// Textures are reference counted by the views drawing them and freed once the last one lets go.
+	class AssetService
+	{
+	private:
+		struct LoadedAsset
+		{
+			std::string path;
+			std::atomic<bool> decoded;
+			bool decode_failed = false;
+			bool uploaded = false;
+			bool from_pack = false;
+			int reference_count = 0;
+			std::size_t memory_bytes = 0;       // GPU, OpenAL or font file memory once loaded
+			long long load_microseconds = 0;    // decode plus upload, or unpack for pack assets
+
+			LoadedAsset() : decoded(false) { }
+			virtual ~LoadedAsset() = default;
+
+			virtual PackedAssetType getPackedType() const = 0;
+			virtual void unpack(const AssetPack& pack, const PackEntry& entry, const sf::Texture& atlas_texture) = 0;
+			virtual void decode() = 0;  // task pool
+			virtual void upload() = 0;  // main thread
+		};
+
+		struct TextureAsset : LoadedAsset
+		{
+			sf::Image image;
+			sf::Texture texture;
+			TextureRegion region;
+
+			PackedAssetType getPackedType() const override { return PackedAssetType::TEXTURE; }
+			void unpack(const AssetPack& pack, const PackEntry& entry, const sf::Texture& atlas_texture) override;
+			void decode() override;
+			void upload() override;
+		};
+
+		// The font keeps pointing at the file bytes, sf::Font reads glyphs from them lazily.
+		struct FontAsset : LoadedAsset
+		{
+			std::vector<char> file_data;
+			sf::Font font;
+
+			PackedAssetType getPackedType() const override { return PackedAssetType::FONT; }
+			void unpack(const AssetPack& pack, const PackEntry& entry, const sf::Texture& atlas_texture) override;
+			void decode() override;
+			void upload() override;
+		};
+
+		struct SoundAsset : LoadedAsset
+		{
+			std::vector<sf::Int16> samples;
+			unsigned int channel_count = 0;
+			unsigned int sample_rate = 0;
+			sf::SoundBuffer buffer;
+
+			PackedAssetType getPackedType() const override { return PackedAssetType::SOUND; }
+			void unpack(const AssetPack& pack, const PackEntry& entry, const sf::Texture& atlas_texture) override;
+			void decode() override;
+			void upload() override;
+		};
+
+		// Fonts read glyphs from the mapping, so the pack is declared first and unmapped last.
+		AssetPack asset_pack;
+		sf::Texture atlas_texture;
+		bool asset_pack_enabled;
+
+		std::map<std::string, std::unique_ptr<TextureAsset>> textures;
+		std::map<std::string, std::unique_ptr<FontAsset>> fonts;
+		std::map<std::string, std::unique_ptr<SoundAsset>> sounds;
+
+		std::vector<LoadedAsset*> pending_uploads;
+		int requested_asset_count;
+		int uploaded_asset_count;
+		bool report_pending;
+		Task::TaskGroup loading_tasks;
+
+		void openAssetPack();
+		void startLoading(LoadedAsset* asset, const std::string& path);
+		void uploadDecodedAssets();
+		void finishLoading(LoadedAsset* asset);
+		void printAssetReport();
+		void printAssetReportLine(const char* type, const LoadedAsset& asset);
+
+		static bool readFile(const std::string& path, std::vector<char>& file_data);
+		static std::vector<PackSource> getStartupAssets();
+
+	public:
+		AssetService();
+		~AssetService();
+
+		void initialize();
+		void update();
+		void destroy();
+
+		// Turned off before initialize() when the pack is about to be rebuilt, it cannot be written while mapped.
+		void setAssetPackEnabled(bool enabled);
+
+		// The build step for the asset pack: packs every startup asset, menu buttons scaled down to the size they are drawn at.
+		static bool buildAssetPack(const std::string& path);
+
+		// A path starts loading in the background the first time it is requested, later requests share it.
+		void requestTexture(const std::string& path);
+		void requestSound(const std::string& path);
+
+		// The font is handed out at once, sf::Text picks up its glyphs as soon as it is loaded.
+		const sf::Font* requestFont(const std::string& path);
+
+		// Request the path if needed and return the asset once it is on the GPU (or in OpenAL), nullptr until then.
+		// Returned assets stay at the same address until the service is destroyed.
+		const TextureRegion* getTextureRegion(const std::string& path);
+		const sf::SoundBuffer* getSound(const std::string& path);
+
+		// Held by every view drawing the texture; the last release frees it unless it is part of the atlas.
+		void acquireTexture(const std::string& path);
+		void releaseTexture(const std::string& path);
+
+		bool isLoading();
+		float getLoadingProgress();
+
+		// Blocks until everything requested so far is decoded and uploaded, for start paths without a splash screen.
+		void waitForAssets();
+
+		// Prints memory, load time and references of every asset once the startup assets are loaded.
+		void setAssetReportEnabled(bool enabled);
+	};
+}
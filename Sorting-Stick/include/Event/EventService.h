@@ -1,6 +1,7 @@
 #pragma once
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/Window/Event.hpp>
+#include "Event/InputDispatcher.h"
 
 namespace Event
 {
@@ -11,20 +12,27 @@ namespace Event
 		RELEASED,
 	};
 
+	// Mouse state comes from the queued events rather than from polling, so a click shorter than a frame still lands.
 	class EventService
 	{
 	private:
 		sf::Event game_event;
 		sf::RenderWindow* game_window;
+		InputDispatcher* input_dispatcher;
 
 		ButtonState left_mouse_button_state;
 		ButtonState right_mouse_button_state;
 
 		bool isGameWindowOpen();
 		bool gameWindowWasClosed();
+		bool gameWindowWasResized();
 		bool hasQuitGame();
 		bool isKeyboardEvent();
-		void updateMouseButtonsState(ButtonState& current_button_state, sf::Mouse::Button mouse_button);
+		void processMouseEvent();
+		void advanceMouseButtonState(ButtonState& current_button_state);
+		void setMouseButtonState(sf::Mouse::Button mouse_button, ButtonState button_state);
+		void releaseMouseButtons();
+		sf::Vector2f getEventPosition(int x_position, int y_position);
 
 	public:
 		EventService();
@@ -40,6 +48,9 @@ namespace Event
 		bool pressedUpArrowKey();
 		bool pressedDownArrowKey();
 		bool pressedLeftMouseButton();
+		bool heldLeftMouseButton();
 		bool pressedRightMouseButton();
+
+		InputDispatcher* getInputDispatcher();
 	};
 }
\ No newline at end of file
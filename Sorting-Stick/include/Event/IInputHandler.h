@@ -0,0 +1,20 @@
+#pragma once
+#include <SFML/Graphics/Rect.hpp>
+
+namespace Event
+{
+	// Something on screen that takes mouse input through the InputDispatcher. Positions are in reference coordinates.
+	// The handler a press lands on keeps receiving the drags and the release that follow it.
+	class IInputHandler
+	{
+	public:
+		virtual bool isAcceptingInput() = 0;
+		virtual sf::FloatRect getInputBounds() = 0;
+
+		virtual void onMousePressed(sf::Vector2f position) = 0;
+		virtual void onMouseDragged(sf::Vector2f /*position*/) { }
+		virtual void onMouseReleased(sf::Vector2f /*position*/) { }
+
+		virtual ~IInputHandler() { }
+	};
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+#include "Event/IInputHandler.h"
+
+namespace Event
+{
+	// Routes mouse events to the handler under the cursor. Handlers are bucketed into a coarse grid over the reference
+	// resolution, so a press only tests the few handlers of one cell; the grid is rebuilt on the next press after a
+	// handler is added, removed or moved. Handlers registered later are considered on top of earlier ones.
+	//
+	// A handler is only hit while it is updated: it stamps itself with getFrame() from its update(), and the stamp is
+	// still current when the next frame's events are dispatched.
+	class InputDispatcher
+	{
+	private:
+		const float cell_size = 128.f;
+
+		int column_count;
+		int row_count;
+
+		std::vector<IInputHandler*> handlers;
+		std::vector<std::vector<IInputHandler*>> cells;
+		bool cells_dirty;
+
+		IInputHandler* captured_handler;
+		unsigned long long frame;
+
+		void rebuildCells();
+		void addToCells(IInputHandler* handler);
+		int getColumn(float x_position);
+		int getRow(float y_position);
+		IInputHandler* findHandlerAt(sf::Vector2f position);
+
+	public:
+		InputDispatcher();
+
+		void initialize(sf::Vector2f reference_resolution);
+
+		void registerHandler(IInputHandler* handler);
+		void unregisterHandler(IInputHandler* handler);
+		void invalidateBounds();
+
+		void dispatchMousePressed(sf::Vector2f position);
+		void dispatchMouseMoved(sf::Vector2f position);
+		void dispatchMouseReleased(sf::Vector2f position);
+
+		void endFrame();
+		unsigned long long getFrame();
+	};
+}
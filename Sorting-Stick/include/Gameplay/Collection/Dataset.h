@@ -0,0 +1,63 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Global/MappedFile.h"
+#include "Gameplay/Collection/SortVerifier.h"
+
+namespace Gameplay
+{
+    namespace Collection
+    {
+        enum class DatasetFormat
+        {
+            INT32,      // raw little endian 32 bit integers
+            FLOAT32,    // raw little endian 32 bit floats
+            CSV,        // one numeric column of a comma separated file
+        };
+
+        // Keys loaded from a file, kept in the file's own element type. Binary files are mapped copy-on-write and
+        // sorted in place, so only the pages the sort writes take memory and nothing is copied or converted.
+        // CSV values are parsed into doubles in one sequential pass. NaNs and unparsable fields are skipped.
+        class Dataset
+        {
+        private:
+            DatasetFormat format;
+            Global::MappedFile key_file; // int32 and float32 keys
+            std::vector<double> csv_keys;
+            std::uint8_t* key_data;
+            std::size_t key_count;
+            std::size_t skipped_values;
+            SortVerification sort_verification;
+
+            bool loadBinary(const std::string& path);
+            bool loadCsv(const std::string& path, int column);
+
+            static bool parseNumber(const char*& cursor, const char* end, double& value);
+            static std::size_t getElementSize(DatasetFormat format);
+
+        public:
+            Dataset();
+
+            bool load(const std::string& path, DatasetFormat format, int csv_column = 0);
+
+            // Sorts every key in memory, returns how long it took in microseconds.
+            // The result is verified afterwards, outside the timed part.
+            long long sortKeys();
+            const SortVerification& getSortVerification();
+
+            // Writes the keys as they are held, in the file's own element type (float64 for CSV), into a mapped output file.
+            bool saveKeys(const std::string& path);
+
+            // Picks count evenly spaced keys and replaces them by their rank, ties keep the same rank.
+            std::vector<int> sampleKeys(int count);
+
+            std::size_t getKeyCount();
+            std::size_t getSkippedValueCount();
+            DatasetFormat getFormat();
+
+            static bool parseFormat(const std::string& name, DatasetFormat& format);
+        };
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Gameplay/Collection/Dataset.h"
+
+namespace Gameplay
+{
+    namespace Collection
+    {
+        enum class ExternalSortPhase
+        {
+            IDLE,
+            RUN_FORMATION,
+            MERGE,
+            DONE,
+            FAILED,
+        };
+
+        // Snapshot of an external sort, updated once per block so it can be drawn while the sort runs.
+        struct ExternalSortProgress
+        {
+            ExternalSortPhase phase = ExternalSortPhase::IDLE;
+            std::uint64_t element_count = 0;
+            std::uint64_t chunk_elements = 0;   // elements sorted in memory per run
+            std::uint64_t block_elements = 0;   // elements per read or write during the merge
+
+            std::uint64_t elements_read = 0;    // run formation: input consumed so far
+            std::vector<std::uint64_t> run_lengths;
+
+            int merge_pass = 0;
+            int merge_group = 0;
+            int merge_group_count = 0;
+            std::vector<std::uint64_t> merge_run_lengths;   // the runs of the group being merged
+            std::vector<std::uint64_t> merge_run_positions; // elements of each handed to the loser tree so far
+            std::uint64_t elements_written = 0;             // output of the group being merged
+
+            long long duration_microseconds = 0;
+        };
+
+        // Sorts binary int32 or float32 files larger than memory: the input is cut into memory_budget sized
+        // chunks that are sorted in RAM and written as runs, which are then merged k at a time through a loser tree.
+        // Every run is read through two blocks and the output written through two more, so the next block is
+        // read (or the previous one written) by a task on the pool while the merge works on the current one.
+        class ExternalSorter
+        {
+        private:
+            const std::size_t min_block_bytes = 64 * 1024;
+            const std::size_t max_block_bytes = 4 * 1024 * 1024;
+
+            std::mutex progress_mutex;
+            ExternalSortProgress progress;
+            std::atomic<bool> cancelled;
+
+            template <typename Key> bool sortFile(const std::string& input_path, const std::string& output_path, std::size_t memory_budget);
+            template <typename Key> bool formRuns(const std::string& input_path, const std::string& output_path, std::size_t memory_budget, std::vector<std::string>& run_paths, std::vector<std::uint64_t>& run_lengths);
+            template <typename Key> bool mergeRuns(const std::vector<std::string>& run_paths, const std::vector<std::uint64_t>& run_lengths, const std::string& output_path, std::size_t block_elements);
+
+            void setPhase(ExternalSortPhase phase);
+            static std::string getRunPath(const std::string& output_path, int pass, int run);
+
+        public:
+            ExternalSorter();
+
+            // Blocks until the file is sorted; call from a worker thread and watch getProgress() from the main one.
+            // A sorter is used for a single sort, once cancelled it stays cancelled.
+            bool sort(const std::string& input_path, const std::string& output_path, DatasetFormat format, std::size_t memory_budget);
+            void cancel();
+
+            ExternalSortProgress getProgress();
+        };
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace Gameplay
+{
+    namespace Collection
+    {
+        enum class InputDistribution
+        {
+            SHUFFLED,       // every key 0..N-1 exactly once, in random order
+            UNIFORM,        // independent uniform keys, duplicates allowed
+            ZIPFIAN,        // small keys very often, a long tail of rare large ones
+            FEW_UNIQUE,
+            NEARLY_SORTED,  // ascending, with noise_percent of the keys replaced by random ones
+            REVERSED,
+            SAWTOOTH,
+            ORGAN_PIPE,     // ascending to the middle, then descending
+            GAUSSIAN,
+            ADVERSARIAL,    // worst case for the quick sort's last-element pivot, a different one per seed
+        };
+
+        struct InputSettings
+        {
+            InputDistribution distribution = InputDistribution::SHUFFLED;
+            std::uint64_t seed = 0;
+            int noise_percent = 10;
+            int unique_keys = 5;
+            int sawtooth_teeth = 4;
+        };
+
+        // Fills key arrays with values in [0, count). Every key is a pure function of the seed and its index,
+        // so the same settings always give the same input, large arrays are split over the task pool and the
+        // per-chunk loops are plain arithmetic the compiler can vectorize. The adversarial keys depend on each
+        // other and are generated in a single linear pass instead.
+        class InputGenerator
+        {
+        private:
+            static const std::size_t parallel_threshold = 1 << 16;
+
+            static void generateRange(const InputSettings& settings, int* keys, std::size_t count, std::size_t begin, std::size_t end);
+            static void generateAdversarial(std::uint64_t seed, int* keys, std::size_t count);
+
+            static std::uint64_t hashIndex(std::uint64_t seed, std::uint64_t index);
+            static std::uint64_t permuteIndex(const std::uint64_t* round_keys, int index_bits, std::uint64_t index, std::uint64_t count);
+
+        public:
+            static void generate(const InputSettings& settings, int* keys, std::size_t count);
+            static std::uint64_t createRandomSeed();
+
+            static const char* getDistributionName(InputDistribution distribution);
+            static bool parseDistribution(const char* name, InputDistribution& distribution);
+            static InputDistribution getNextDistribution(InputDistribution distribution);
+        };
+    }
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include "Gameplay/Collection/LoserTree.h"
+
+namespace Gameplay
+{
+    namespace Collection
+    {
+        // Merges any number of sorted ranges through a LoserTree, log2(k) comparisons per element.
+        // Equal keys come out in the order of the ranges they were taken from, so merging adjacent runs is stable.
+        class KWayMerge
+        {
+        public:
+            template <typename Iterator>
+            using Range = std::pair<Iterator, Iterator>;
+
+            template <typename Iterator, typename OutputIterator,
+                typename Less = std::less<typename std::iterator_traits<Iterator>::value_type>>
+            static OutputIterator merge(std::vector<Range<Iterator>> ranges, OutputIterator output, Less less = Less())
+            {
+                typedef typename std::iterator_traits<Iterator>::value_type Key;
+
+                if (ranges.empty()) return output;
+
+                LoserTree<Key, Less> tree(static_cast<int>(ranges.size()), less);
+                for (int i = 0; i < ranges.size(); i++)
+                {
+                    if (ranges[i].first != ranges[i].second) tree.setSourceKey(i, *ranges[i].first);
+                }
+                tree.build();
+
+                while (!tree.isEmpty())
+                {
+                    Range<Iterator>& range = ranges[tree.getWinnerSource()];
+                    *output++ = tree.getWinnerKey();
+
+                    if (++range.first != range.second) tree.replaceWinner(*range.first);
+                    else tree.removeWinner();
+                }
+
+                return output;
+            }
+        };
+    }
+}
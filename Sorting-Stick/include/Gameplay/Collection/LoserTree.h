@@ -0,0 +1,96 @@
+#pragma once
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace Gameplay
+{
+    namespace Collection
+    {
+        // Tournament tree over k sorted sources that keeps the loser of every match in the inner nodes.
+        // Replacing the winner replays only its leaf-to-root path, log2(k) comparisons against the stored losers.
+        // Nodes hold the key itself rather than a source index, so that walk never leaves the node array.
+        // Equal keys are won by the lower source index, which keeps merges of adjacent runs stable.
+        template <typename Key, typename Less = std::less<Key>>
+        class LoserTree
+        {
+        private:
+            struct Entry
+            {
+                Key key;
+                int source;
+                bool exhausted;
+            };
+
+            int source_count;
+            std::vector<Entry> nodes; // nodes[0] is the winner, nodes[1..source_count-1] the losers
+            std::vector<Entry> leaves;
+            Less less;
+
+            bool beats(const Entry& first, const Entry& second) const
+            {
+                if (first.exhausted != second.exhausted) return second.exhausted;
+                if (!first.exhausted)
+                {
+                    if (less(first.key, second.key)) return true;
+                    if (less(second.key, first.key)) return false;
+                }
+                return first.source < second.source;
+            }
+
+            Entry playMatch(int node)
+            {
+                if (node >= source_count) return leaves[node - source_count];
+
+                Entry left = playMatch(2 * node);
+                Entry right = playMatch(2 * node + 1);
+                if (beats(left, right))
+                {
+                    nodes[node] = right;
+                    return left;
+                }
+                nodes[node] = left;
+                return right;
+            }
+
+            void replay(Entry candidate)
+            {
+                for (int node = (candidate.source + source_count) / 2; node > 0; node /= 2)
+                {
+                    if (beats(nodes[node], candidate)) std::swap(nodes[node], candidate);
+                }
+                nodes[0] = candidate;
+            }
+
+        public:
+            explicit LoserTree(int source_count, Less less = Less())
+                : source_count(source_count), nodes(source_count), leaves(source_count), less(less)
+            {
+                for (int i = 0; i < source_count; i++) leaves[i] = Entry{ Key(), i, true };
+            }
+
+            // Sets the first key of each source before build(); sources that are never set count as empty.
+            void setSourceKey(int source, const Key& key) { leaves[source] = Entry{ key, source, false }; }
+
+            void build() { nodes[0] = playMatch(1); }
+
+            bool isEmpty() const { return nodes[0].exhausted; }
+            int getWinnerSource() const { return nodes[0].source; }
+            const Key& getWinnerKey() const { return nodes[0].key; }
+
+            // The winning source produced its next key.
+            void replaceWinner(const Key& key) { replay(Entry{ key, nodes[0].source, false }); }
+
+            // The winning source has run out.
+            void removeWinner() { replay(Entry{ Key(), nodes[0].source, true }); }
+
+            // Read only views of the nodes, for drawing the tree: the next replay of a source starts at
+            // getLeafParent(source) and halves the node index until it reaches 1.
+            int getSourceCount() const { return source_count; }
+            int getLeafParent(int source) const { return (source + source_count) / 2; }
+            bool isNodeEmpty(int node) const { return nodes[node].exhausted; }
+            int getNodeSource(int node) const { return nodes[node].source; }
+            const Key& getNodeKey(int node) const { return nodes[node].key; }
+        };
+    }
+}
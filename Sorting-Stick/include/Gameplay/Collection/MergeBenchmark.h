@@ -0,0 +1,33 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Gameplay/Collection/SortVerifier.h"
+
+namespace Gameplay
+{
+    namespace Collection
+    {
+        struct MergeBenchmarkResult
+        {
+            int source_count = 0;
+            double milliseconds = 0.0;
+            double nanoseconds_per_key = 0.0;
+            bool verified = false; // sorted and holding exactly the input keys
+        };
+
+        // Times KWayMerge on the same keys cut into k sorted runs, for k = 2, 4, ... max_source_count.
+        // Only the merge is timed; each k is run a few times, the fastest one kept and every output verified.
+        class MergeBenchmark
+        {
+        private:
+            static const int repetitions = 3;
+
+            static MergeBenchmarkResult measure(const std::vector<int>& keys, const MultisetHash& keys_hash, int source_count, std::vector<int>& output);
+
+        public:
+            static std::vector<MergeBenchmarkResult> run(std::size_t key_count, int max_source_count = 1024, std::uint64_t seed = 1);
+            static void print(const std::vector<MergeBenchmarkResult>& results, std::size_t key_count);
+        };
+    }
+}
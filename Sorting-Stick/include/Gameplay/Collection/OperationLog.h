@@ -0,0 +1,142 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "Global/MappedFile.h"
+#include "Gameplay/Collection/StickCollectionModel.h"
+
+namespace Gameplay
+{
+    namespace Collection
+    {
+        enum class OperationType : std::uint8_t
+        {
+            STEP,           // first = delay in ms, second = comparisons since last step, third = array accesses since last step
+            SWAP,           // first, second = positions, its own inverse
+            WRITE,          // first = position, second = stick id written there, third = stick id it replaced
+            SET_COLOR,      // first = position, second = new ElementColor, third = previous ElementColor
+            PLAY_SOUND,     // first = position of the stick compared, pitches the tone
+            KEYFRAME,       // full array snapshot, skipped during normal playback
+            MERGE_NODE,     // first = loser tree node, second = new node state, third = previous node state
+        };
+
+        struct Operation
+        {
+            OperationType type;
+            int first = 0;
+            int second = 0;
+            int third = 0;
+        };
+
+        struct OperationLogKeyframe
+        {
+            std::int64_t operation_index = 0;
+            std::vector<int> stick_ids;
+            std::vector<ElementColor> colors;
+            std::int64_t number_of_comparisons = 0;
+            std::int64_t number_of_array_access = 0;
+        };
+
+        // Layout: header, varint encoded operation stream with inline keyframes, keyframe table, fixed size footer.
+        // Every record ends with its own length (one byte for operations, four bytes and a zero byte for keyframes),
+        // so the stream can be walked backwards as cheaply as forwards.
+        class OperationLogFormat
+        {
+        public:
+            static const std::uint32_t magic = 0x4C4F5353; // "SSOL"
+            static const std::uint32_t version = 3;
+            static const std::size_t footer_size = 40;
+            static const std::size_t keyframe_trailer_size = 5;
+
+            static void writeVarint(std::vector<std::uint8_t>& buffer, std::uint64_t value);
+            static bool readVarint(const std::uint8_t* data, std::size_t size, std::size_t& offset, std::uint64_t& value);
+
+            static void writeFixed(std::vector<std::uint8_t>& buffer, std::uint64_t value, int byte_count);
+            static std::uint64_t readFixed(const std::uint8_t* data, int byte_count);
+        };
+
+        class OperationLogWriter
+        {
+        private:
+            // Operations are encoded into this buffer and flushed in large blocks.
+            const std::size_t flush_threshold = 1 << 20;
+
+            std::FILE* log_file;
+            bool in_memory;
+            std::vector<std::uint8_t> buffer;
+            std::uint64_t bytes_written;
+
+            int keyframe_interval;
+            std::int64_t operation_count;
+            std::int64_t operations_since_keyframe;
+            std::vector<std::pair<std::int64_t, std::uint64_t>> keyframe_table;
+
+            void flush();
+            void writeHeader(SortType sort_type, const std::vector<int>& element_data, int interval);
+            void writeRecordLength(std::size_t record_start);
+
+        public:
+            OperationLogWriter();
+            ~OperationLogWriter();
+
+            bool open(const std::string& path, SortType sort_type, const std::vector<int>& element_data, int keyframe_interval);
+            // Keeps the whole log in memory, to be handed to OperationLogReader::open(buffer) once closed.
+            void openInMemory(SortType sort_type, const std::vector<int>& element_data, int keyframe_interval);
+            void close();
+            std::vector<std::uint8_t> releaseBuffer();
+
+            void writeOperation(const Operation& operation);
+            void writeKeyframe(const OperationLogKeyframe& keyframe);
+            bool needsKeyframe();
+
+            std::int64_t getOperationCount();
+        };
+
+        class OperationLogReader
+        {
+        private:
+            Global::MappedFile mapped_file;
+            std::vector<std::uint8_t> log_buffer;
+            const std::uint8_t* log_data;
+            std::size_t log_size;
+
+            SortType sort_type;
+            int keyframe_interval;
+            std::vector<int> element_data;
+            std::int64_t operation_count;
+            std::size_t stream_start;
+            std::size_t stream_end;
+            std::vector<std::pair<std::int64_t, std::uint64_t>> keyframe_table;
+
+            bool readLog();
+            bool readHeader();
+            bool readFooter();
+            bool readKeyframeAt(std::size_t& offset, OperationLogKeyframe& keyframe);
+            bool decodeOperation(std::size_t& offset, Operation& operation);
+
+        public:
+            OperationLogReader();
+
+            bool open(const std::string& path);
+            bool open(std::vector<std::uint8_t>&& buffer);
+            void close();
+            bool isOpen();
+
+            // Decodes the operation at offset and moves offset past it, skipping over inline keyframes.
+            bool readOperation(std::size_t& offset, Operation& operation);
+
+            // Decodes the operation that ends at offset and moves offset back to its start, skipping over inline keyframes.
+            bool readPreviousOperation(std::size_t& offset, Operation& operation);
+
+            // Loads the last keyframe at or before operation_index; offset is set to the first operation after it.
+            bool seekKeyframe(std::int64_t operation_index, OperationLogKeyframe& keyframe, std::size_t& offset);
+
+            SortType getSortType();
+            int getKeyframeInterval();
+            int getElementCount();
+            const std::vector<int>& getElementData();
+            std::int64_t getOperationCount();
+        };
+    }
+}
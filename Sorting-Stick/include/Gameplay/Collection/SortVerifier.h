@@ -0,0 +1,57 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace Gameplay
+{
+    namespace Collection
+    {
+        // Order independent fingerprint of a multiset of keys: two sums of differently mixed key bits.
+        // Equal multisets always match; different ones collide with probability around 2^-64.
+        struct MultisetHash
+        {
+            std::uint64_t first_sum = 0;
+            std::uint64_t second_sum = 0;
+            std::uint64_t count = 0;
+
+            bool operator==(const MultisetHash& other) const;
+            bool operator!=(const MultisetHash& other) const;
+        };
+
+        struct SortVerification
+        {
+            bool sorted = true;
+            bool permutation = true;         // the output holds exactly the input keys
+            bool stability_checked = false;  // only possible when the output carries the input index of every key
+            bool stable = true;              // equal keys kept their input order
+            std::size_t first_unsorted_index = 0;
+            std::size_t first_unstable_index = 0;
+
+            bool isValid(bool require_stability) const;
+        };
+
+        // Checks sort results after the fact, without trusting the algorithm that produced them.
+        // Large arrays are split over the task pool, each chunk also checking the pair across its left edge.
+        class SortVerifier
+        {
+        private:
+            static const std::size_t parallel_threshold = 1 << 16;
+
+        public:
+            static MultisetHash hashKeys(const int* keys, std::size_t count);
+            static MultisetHash hashKeys(const float* keys, std::size_t count);
+            static MultisetHash hashKeys(const double* keys, std::size_t count);
+
+            // Sortedness plus a multiset hash against input_hash, taken before the keys were sorted in place.
+            static SortVerification verify(const int* output, std::size_t count, const MultisetHash& input_hash);
+            static SortVerification verify(const float* output, std::size_t count, const MultisetHash& input_hash);
+            static SortVerification verify(const double* output, std::size_t count, const MultisetHash& input_hash);
+
+            // output_origins[i] is the index in input the key at output[i] was taken from, so besides sortedness
+            // every key must match its origin, the origins must be a permutation and equal keys must keep their order.
+            static SortVerification verifyTagged(const int* input, const int* output, const int* output_origins, std::size_t count);
+
+            static void printFailures(const SortVerification& verification, const char* name, bool require_stability);
+        };
+    }
+}
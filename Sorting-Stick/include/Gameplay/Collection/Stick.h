@@ -1,5 +1,6 @@
 #pragma once
 #include "UI/UIElement/RectangleShapeView.h"
+#include "Gameplay/Collection/StickCollectionModel.h"
 
 namespace Gameplay
 {
@@ -7,14 +8,22 @@ namespace Gameplay
     {
         struct Stick
         {
+            int id;
             int data;
+            ElementColor color;            // highlight state on screen; the palette is applied when drawing
+            unsigned int highlight_frame;  // display frame the color was set on, for highlights that expire
+            bool recolor_queued;           // already in the controller's recolored_sticks for the next render
             UI::UIElement::RectangleShapeView* stick_view;
 
             Stick() { }
 
-            Stick(int data)
+            Stick(int id, int data)
             {
+                this->id = id;
                 this->data = data;
+                color = ElementColor::DEFAULT;
+                highlight_frame = 0;
+                recolor_queued = false;
                 stick_view = new UI::UIElement::RectangleShapeView();
             }
 
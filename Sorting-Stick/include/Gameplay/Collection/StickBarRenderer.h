@@ -0,0 +1,47 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "Gameplay/Collection/StickCollectionModel.h"
+
+namespace Gameplay
+{
+    namespace Collection
+    {
+        // Draws a whole collection as one quad: every bar's height and colour live in one texel of a data texture, and
+        // a fragment shader works out which bar, if any, covers each pixel. Changed bars are written to a copy in memory
+        // and only the rows between the first and last of them are uploaded before the next draw, so the cost of a frame
+        // follows what changed rather than the number of bars.
+        class StickBarRenderer
+        {
+        private:
+            static const unsigned int max_data_texture_width = 4096;
+            static const int bytes_per_texel = 4;
+
+            sf::Texture data_texture;
+            sf::Texture palette_texture;
+            sf::Shader bar_shader;
+            sf::VertexArray bar_quad;
+
+            std::vector<sf::Uint8> texels;
+            unsigned int data_texture_width;
+            unsigned int data_texture_height;
+            int element_count;
+            int dirty_first;
+            int dirty_last;
+
+            bool createPalette(StickCollectionModel* collection_model);
+            void uploadDirtyRows();
+
+        public:
+            StickBarRenderer();
+
+            static bool isAvailable();
+
+            bool initialize(StickCollectionModel* collection_model);
+            void render(sf::RenderTarget* render_target);
+
+            // height_fraction in (0, 1] of the collection height.
+            void setBar(int index, float height_fraction, ElementColor color);
+        };
+    }
+}
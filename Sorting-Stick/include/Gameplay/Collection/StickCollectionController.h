@@ -1,51 +1,170 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include <vector>
-#include <thread>
+#include <queue>
+#include <atomic>
+#include <string>
+#include <cstdint>
+#include "Gameplay/Collection/InputGenerator.h"
+#include "Gameplay/Collection/SortVerifier.h"
+#include "Task/TaskService.h"
 
 namespace Gameplay
 {
     namespace Collection
     {
         class StickCollectionView;
+        class StickBarRenderer;
         class StickCollectionModel;
+        class OperationLogWriter;
+        class OperationLogReader;
+        struct Operation;
+        struct OperationLogKeyframe;
         struct Stick;
         enum class SortType;
         enum class SortState;
+        enum class ElementColor : sf::Uint8;
 
         class StickCollectionController
         {
         private:
+            // A highlight set on a display index, checked again once its lifetime is over.
+            struct HighlightExpiry
+            {
+                unsigned int due_frame;
+                unsigned int highlight_frame;
+                int index;
+
+                bool operator>(const HighlightExpiry& other) const { return due_frame > other.due_frame; }
+            };
+
             StickCollectionView* collection_view;
             StickCollectionModel* collection_model;
+            StickBarRenderer* bar_renderer; // replaces the stick views once shader rendering is enabled
+
+            // Display colors are one ElementColor per stick; views are only recolored when drawn, once per frame at most.
+            unsigned int display_frame;
+            std::vector<Stick*> recolored_sticks;
+            std::priority_queue<HighlightExpiry, std::vector<HighlightExpiry>, std::greater<HighlightExpiry>> highlight_expiries;
 
-            std::vector<Stick*> sticks;
+            std::vector<Stick*> sticks;         // the order the sort thread works on
+            std::vector<Stick*> display_sticks; // the order on screen, driven by log playback
+            std::vector<Stick*> stick_pool;     // every stick indexed by id, owns them
+            std::vector<ElementColor> sort_colors; // highlight of each stick id as seen by the sort thread
+            std::vector<int> merge_tree_states;      // loser tree nodes on screen during a multiway merge
+            std::vector<int> sort_merge_tree_states; // the same nodes as seen by the sort thread
+            InputSettings input_settings;
+            bool randomize_input_seed;
+            std::vector<int> input_keys; // fixed keys, e.g. sampled from a dataset, used instead of the generator
             SortType sort_type;
             SortState sort_state;
 
-            std::thread sort_thread;
+            // Sorts run at full speed into an operation log; what is shown is a replay of that log.
+            // The sort thread is a task on the shared pool; sort_task_pending stays set until the main thread has seen it finish.
+            Task::TaskGroup sort_task;
+            bool sort_task_pending;
+            std::atomic<bool> sort_thread_finished;
+            std::atomic<bool> sort_cancelled;
+
+            // A reset does not wait for the cancelled sort: it winds down on its own while input_task draws the next
+            // keys into a second buffer, and update() swaps them in once both are done.
+            Task::TaskGroup input_task;
+            bool reset_pending;
+            std::vector<int> next_input_keys; // written by input_task until it is idle
+            bool fixed_timestep;
+            bool sound_enabled;
+
+            // Progress published by the sort thread, read by the renderer without taking a lock.
+            std::atomic<std::int64_t> published_operation_count;
+            std::atomic<long long> sort_duration_microseconds;
+
+            // The keys as the sort found them and where each stick id started, to verify the result against.
+            std::vector<int> verification_input_keys;
+            std::vector<int> verification_start_positions;
+            SortVerification sort_verification; // written by the sort thread before it finishes
+
+            // Recording: written by the sort thread only, opened and closed on the main thread.
+            std::string operation_log_record_path;
+            OperationLogWriter* operation_log_writer;
+            int recorded_comparisons;
+            int recorded_array_access;
+
+            // Playback of a recorded log, applied on the main thread without running the algorithm.
+            OperationLogReader* operation_log_reader;
+            std::size_t playback_offset;
+            std::int64_t playback_operation_index;
+            double playback_time;
+            double playback_pending_delay;
+            bool skip_playback_delays;
+            bool playback_paused;
+            bool playback_reversed;
 
             int number_of_comparisons;
             int number_of_array_access;
+            int playback_comparisons;
+            int playback_array_access;
             int current_operation_delay;
-            int color_delay;
 
             int delay_in_ms;
             sf::String time_complexity;
 
             void initializeSticks();
             float calculateStickWidth();
-            float calculateStickHeight(int array_pos);
+            float calculateStickHeight(int data);
+            void updateStickHeights();
 
             void updateStickPosition();
             void updateStickPosition(int i);
-            void shuffleSticks();
+            void updateBar(int i);
+            void updateBars();
+            void updateDisplayStick(int i);
+            ElementColor getShownColor(const Stick* stick);
+            void trackHighlight(int index);
+            void processHighlightExpiries();
+            void queueRecolor(Stick* stick);
+            void applyRecoloredSticks();
+            void prepareInput();
+            void applyInput();
+            void processPendingReset();
+            void completeReset();
             bool compareSticksByData(const Stick* a, const Stick* b) const;
 
             void resetSticksColor();
             void resetVariables();
 
             void processSortThreadState();
+            void processSortThread(void (StickCollectionController::*sort_function)());
+            void cancelSortThread();
+
+            void swapSticks(int first, int second);
+            void setStick(int index, Stick* stick);
+            void setStickColor(int index, ElementColor color);
+            void setMergeTreeNode(int node, int stick_id, bool lit);
+            static int encodeMergeTreeNode(int stick_id, bool lit);
+            void playCompareSound(int index);
+
+            void startRecording();
+            void stopRecording();
+            void recordOperation(const Operation& operation);
+            void recordStep(long delay_in_ms);
+            void recordOperationStep();
+            void recordColorStep();
+            OperationLogKeyframe createKeyframe();
+
+            void playRecordedLog();
+            bool startPlayback();
+            bool restoreKeyframe(std::int64_t operation_index);
+            void processPlayback();
+            void finishPlayback();
+            bool stepPlaybackForward(long& delay_in_ms, bool play_sound);
+            bool stepPlaybackBackward(long& delay_in_ms, bool play_sound);
+            void applyOperation(const Operation& operation, bool play_sound);
+            void undoOperation(const Operation& operation, bool play_sound);
+            void setDisplayStickColor(int index, ElementColor color);
+            void setDisplayMergeTreeNode(int node, int state);
+            void clearDisplayMergeTree();
+            void applyKeyframe(const OperationLogKeyframe& keyframe);
+            void stopPlayback();
 
             void processBubbleSort();
             void processInsertionSort();
@@ -53,6 +172,7 @@ namespace Gameplay
             void processMergeSort();
             void processQuickSort();
             void processRadixSort();
+            void processMultiwayMergeSort();
 
             void countSort(int exponent);
 
@@ -66,13 +186,18 @@ namespace Gameplay
 
             void mergeSort(int left, int right);
 
+            void multiwayMerge(const std::vector<int>& run_starts);
+
+            void multiwayMergeSort(int left, int right);
+
             void inPlaceMergeSort(int left, int right);
 
             void inPlaceMerge(int left, int mid, int right);
 
             void setCompletedColor();
 
-            bool isCollectionSorted();
+            void verifySort();
+            static bool isStableSortType(SortType sort_type);
             void destroy();
 
         public:
@@ -85,6 +210,39 @@ namespace Gameplay
 
             void reset();
             void sortElements(SortType sort_type);
+            bool isSorting();
+
+            void setFixedTimestep(bool enabled);
+            void advanceSimulationTime(double milliseconds);
+
+            void setCollectionBounds(sf::FloatRect bounds);
+            bool setShaderRendering(bool enabled);
+            void setHighlightLifetime(int frames);
+            void setSoundEnabled(bool enabled);
+            void setInputDistribution(InputDistribution distribution);
+            void setInputSeed(std::uint64_t seed);
+            const InputSettings& getInputSettings();
+            void setInputKeys(const std::vector<int>& keys);
+            const std::vector<int>& getInputKeys();
+
+            bool isRecording();
+            std::int64_t getRecordedOperationCount();
+            long long getSortDurationMicroseconds();
+            // Only meaningful once isRecording() is false.
+            const SortVerification& getSortVerification();
+
+            void setOperationLogRecordPath(const std::string& path);
+            bool playOperationLog(const std::string& path, std::int64_t start_operation = 0);
+            bool seekOperationLog(std::int64_t operation_index);
+
+            bool hasTimeline();
+            void setPlaybackPaused(bool paused);
+            bool isPlaybackPaused();
+            void setPlaybackReversed(bool reversed);
+            bool isPlaybackReversed();
+            void stepPlayback(bool forward);
+            std::int64_t getPlaybackOperationIndex();
+            std::int64_t getPlaybackOperationCount();
 
             SortType getSortType();
             int getNumberOfComparisons();
@@ -95,4 +253,4 @@ namespace Gameplay
             sf::String getTimeComplexity();
         };
     }
-}
\ No newline at end of file
+}
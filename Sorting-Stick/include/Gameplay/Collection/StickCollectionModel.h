@@ -13,6 +13,7 @@ namespace Gameplay
             MERGE_SORT,
             QUICK_SORT,
             RADIX_SORT,
+            MULTIWAY_MERGE_SORT,
         };
 
         enum class SortState
@@ -21,14 +22,30 @@ namespace Gameplay
             NOT_SORTING,
         };
 
+        // Stored as a single byte per stick and in operation logs, resolved to an sf::Color when drawn.
+        enum class ElementColor : sf::Uint8
+        {
+            DEFAULT,
+            PROCESSING,
+            PLACEMENT_POSITION,
+            SELECTED,
+            TEMPORARY_PROCESSING,
+        };
+
         class StickCollectionModel
         {
         public:
             int number_of_elements = 20;
-            const float max_element_height = 820.f;
+            float max_element_height = 820.f;
             float elements_spacing = 25.f; //acttual amount of spacing between sticks
             float space_percentage = 0.40f; //the percentage of the screen space allocated to spacing (0 - 1)
-            const float element_y_position = 1020.f;
+            float element_y_position = 1020.f;
+            int highlight_lifetime_frames = 0; // highlights fade back to DEFAULT after this many frames, 0 keeps them
+
+            // Area the collection is laid out in, in reference resolution coordinates.
+            float collection_x_position = 0.f;
+            float collection_width = 1920.f;
+            float element_width = 0.f;
 
             const sf::Color element_color = sf::Color::White;
             const sf::Color processing_element_color = sf::Color::Red;
@@ -39,12 +56,20 @@ namespace Gameplay
             const long operation_delay = 150;
             const long initial_color_delay = 40;
 
+            const int multiway_merge_fan_in = 4; // runs per merge, small enough for the loser tree to be drawn
+
+            const int operation_log_keyframe_interval = 4096;
+            const int max_skipped_playback_steps = 100000; // per frame, when headless playback ignores delays
+            const int max_playback_operations_per_frame = 20000; // per frame, when playback follows the delays
+
             StickCollectionModel();
             ~StickCollectionModel();
 
             void initialize();
 
             void setElementSpacing(float space);
+            void setCollectionBounds(sf::FloatRect bounds);
+            sf::Color getElementColor(ElementColor color);
         };
     }
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <vector>
 #include "UI/UIElement/ImageView.h"
+#include "UI/UIElement/RectangleShapeView.h"
 
 namespace Gameplay
 {
@@ -11,7 +13,30 @@ namespace Gameplay
         class StickCollectionView
         {
         private:
+            // The loser tree of a multiway merge is drawn in the top right corner of the collection, winner on top.
+            const float merge_tree_width_percentage = 0.3f;
+            const float max_merge_tree_node_size = 48.f;
+            const float merge_tree_level_spacing = 0.4f; // gap between levels as a fraction of the node size
+            const float merge_tree_key_bar_width = 0.4f;
+
+            const sf::Color merge_tree_node_color = sf::Color(70, 70, 70);
+            const sf::Color merge_tree_lit_node_color = sf::Color(220, 160, 0);
+            const sf::Color merge_tree_key_color = sf::Color::White;
+
+            struct MergeTreeNode
+            {
+                UI::UIElement::RectangleShapeView* background;
+                UI::UIElement::RectangleShapeView* key_bar;
+                sf::Vector2f position;
+                bool visible;
+            };
+
             StickCollectionController* collection_controller;
+            std::vector<MergeTreeNode> merge_tree_nodes;
+            float merge_tree_node_size;
+
+            sf::Vector2f getMergeTreeNodePosition(int node, sf::FloatRect area);
+            void destroyMergeTree();
 
         public:
             StickCollectionView();
@@ -20,6 +45,11 @@ namespace Gameplay
             void initialize(StickCollectionController* collection_controller);
             void update();
             void render();
+
+            void createMergeTree(int node_count, sf::FloatRect collection_bounds);
+            // key_fraction in (0, 1] sets the height of the key drawn inside the node.
+            void showMergeTreeNode(int node, float key_fraction, bool lit);
+            void hideMergeTreeNode(int node);
         };
     }
-}
\ No newline at end of file
+}
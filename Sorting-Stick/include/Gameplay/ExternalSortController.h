@@ -0,0 +1,73 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <string>
+#include <vector>
+#include "Gameplay/Collection/ExternalSorter.h"
+#include "UI/UIElement/RectangleShapeView.h"
+#include "Task/TaskService.h"
+
+namespace Gameplay
+{
+    // Runs an external sort as a task on the shared pool and draws it at block granularity: the input file while runs
+    // are formed, then one bar per run of the group being merged and the output it is merged into.
+    class ExternalSortController
+    {
+    private:
+        const float area_x_position = 60.f;
+        const float area_width = 1800.f;
+        const float input_row_y_position = 160.f;
+        const float first_run_row_y_position = 230.f;
+        const float output_row_y_position = 960.f;
+        const float row_height = 34.f;
+        const float run_row_spacing = 10.f;
+        const int max_visible_runs = 16;
+
+        const sf::Color pending_block_color = sf::Color(70, 70, 70);
+        const sf::Color done_block_color = sf::Color::Green;
+        const sf::Color active_block_color = sf::Color::Yellow;
+        const sf::Color output_block_color = sf::Color(60, 110, 200);
+
+        struct BlockRow
+        {
+            UI::UIElement::RectangleShapeView* background;
+            UI::UIElement::RectangleShapeView* done_blocks;
+            UI::UIElement::RectangleShapeView* active_block;
+            float y_position;
+            bool visible;
+        };
+
+        Collection::ExternalSorter* sorter; // one per sort, so a cancel never leaks into the next one
+        Task::TaskGroup sort_task;
+        std::atomic<bool> sort_thread_finished;
+        bool active;
+
+        Collection::ExternalSortProgress progress;
+        BlockRow input_row;
+        BlockRow output_row;
+        std::vector<BlockRow> run_rows;
+
+        void createRow(BlockRow& row, float y_position, sf::Color done_color);
+        void destroyRow(BlockRow& row);
+        void updateRow(BlockRow& row, std::uint64_t done_elements, std::uint64_t active_elements, std::uint64_t total_elements, std::uint64_t block_elements);
+        void renderRow(BlockRow& row);
+
+        void updateRunFormationRows();
+        void updateMergeRows();
+
+    public:
+        ExternalSortController();
+        ~ExternalSortController();
+
+        void initialize();
+        void update();
+        void render();
+
+        void startSort(const std::string& input_path, const std::string& output_path, Collection::DatasetFormat format, std::size_t memory_budget);
+        void stopSort();
+
+        bool isActive();
+        bool isSorting();
+        const Collection::ExternalSortProgress& getProgress();
+    };
+}
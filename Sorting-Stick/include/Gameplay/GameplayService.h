@@ -1,6 +1,10 @@
 #pragma once
 #include "Gameplay/Collection/StickCollectionModel.h"
 #include "Gameplay/Collection/StickCollectionController.h"
+#include "Gameplay/RaceController.h"
+#include "Gameplay/ExternalSortController.h"
+#include "Gameplay/Collection/Dataset.h"
+#include <vector>
 
 namespace Gameplay
 {
@@ -12,6 +16,9 @@ namespace Gameplay
 	private:
 		GameplayController* gameplay_controller;
 		StickCollectionController* collection_controller;
+		RaceController* race_controller;
+		ExternalSortController* external_sort_controller;
+		Dataset* dataset;
 
 	public:
 		GameplayService();
@@ -23,6 +30,39 @@ namespace Gameplay
 
 		void reset();
 		void sortElement(Collection::SortType search_type);
+		bool isSorting();
+
+		void startRace(const std::vector<Collection::SortType>& sort_types);
+		bool isRacing();
+		RaceController* getRaceController();
+
+		void startExternalSort(const std::string& input_path, const std::string& output_path, Collection::DatasetFormat format, std::size_t memory_budget);
+		ExternalSortController* getExternalSortController();
+
+		void setInputDistribution(Collection::InputDistribution distribution);
+		Collection::InputDistribution getInputDistribution();
+		void setInputSeed(std::uint64_t seed);
+
+		bool loadDataset(const std::string& path, Collection::DatasetFormat format, int csv_column);
+		bool sortDataset(const std::string& output_path);
+
+		void setFixedTimestep(bool enabled);
+		void advanceSimulationTime(double milliseconds);
+		bool setShaderStickRendering(bool enabled);
+		void setHighlightLifetime(int frames);
+
+		void setOperationLogRecordPath(const std::string& path);
+		bool playOperationLog(const std::string& path, long long start_operation);
+
+		bool hasTimeline();
+		void setPlaybackPaused(bool paused);
+		bool isPlaybackPaused();
+		void setPlaybackReversed(bool reversed);
+		bool isPlaybackReversed();
+		void stepPlayback(bool forward);
+		void seekPlayback(long long operation_index);
+		long long getPlaybackOperationIndex();
+		long long getPlaybackOperationCount();
 
 		Collection::SortType getSortType();
 		int getNumberOfComparisons();
@@ -0,0 +1,48 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "Gameplay/Collection/StickCollectionModel.h"
+#include "Gameplay/Collection/InputGenerator.h"
+
+namespace Gameplay
+{
+    namespace Collection
+    {
+        class StickCollectionController;
+    }
+
+    // Runs several sort types side by side on the same input, each collection in its own grid cell.
+    class RaceController
+    {
+    private:
+        const int grid_columns = 3;
+        const float grid_x_position = 0.f;
+        const float grid_y_position = 120.f;
+        const float grid_width = 1920.f;
+        const float grid_height = 900.f;
+        const float cell_padding = 30.f;
+        const float cell_label_height = 70.f;
+
+        std::vector<Collection::StickCollectionController*> race_collections;
+
+        sf::FloatRect calculateCellBounds(int index, int count);
+        sf::FloatRect calculateCollectionBounds(int index, int count);
+
+    public:
+        RaceController();
+        ~RaceController();
+
+        void update();
+        void render();
+        void advanceSimulationTime(double milliseconds);
+
+        void startRace(const std::vector<Collection::SortType>& sort_types, const Collection::InputSettings& input_settings, const std::vector<int>& input_keys);
+        void stopRace();
+        bool isRacing();
+        bool isSorting();
+
+        int getCollectionCount();
+        Collection::StickCollectionController* getCollection(int index);
+        sf::FloatRect getCellBounds(int index);
+    };
+}
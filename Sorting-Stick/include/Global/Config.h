@@ -21,7 +21,8 @@ namespace Global
 		static const sf::String bubble_bobble_font_path;
 		static const sf::String DS_DIGIB_font_path;
 
-		static const sf::String compare_sfx_sound_path;;
 		static const sf::String button_click_sound_path;
+
+		static const sf::String asset_pack_path;
 	};
 }
\ No newline at end of file
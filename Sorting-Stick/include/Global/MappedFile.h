@@ -0,0 +1,52 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Global
+{
+	// Read-ahead hint for open(): datasets are read front to back, logs also seek and play backwards.
+	enum class MappedFileAccess
+	{
+		SEQUENTIAL,
+		NORMAL,
+	};
+
+	// Memory mapping of a whole file, so large logs and datasets are paged in by the OS on demand.
+	// create() maps a new file writable instead, results are written straight into the page cache.
+	// openCopyOnWrite() maps an existing file writable, but changes stay private: only the pages written to take
+	// memory of their own, the file itself is never modified.
+	class MappedFile
+	{
+	private:
+#ifdef _WIN32
+		void* file_handle;
+		void* mapping_handle;
+#else
+		int file_descriptor;
+#endif
+		const std::uint8_t* data;
+		std::size_t size;
+		bool writable;
+
+		bool openMapping(const std::string& path, MappedFileAccess access, bool copy_on_write);
+
+	public:
+		MappedFile();
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		bool open(const std::string& path, MappedFileAccess access = MappedFileAccess::SEQUENTIAL);
+		bool openCopyOnWrite(const std::string& path);
+		bool create(const std::string& path, std::size_t file_size);
+		bool flush();
+		void close();
+
+		bool isOpen() const;
+		const std::uint8_t* getData() const;
+		std::uint8_t* getWritableData();
+		std::size_t getSize() const;
+	};
+}
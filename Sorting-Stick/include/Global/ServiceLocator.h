@@ -4,6 +4,8 @@
 #include "UI/UIService.h"
 #include "Sound/SoundService.h"
 #include "Gameplay/GameplayService.h"
+#include "Task/TaskService.h"
+#include "Asset/AssetService.h"
 
 namespace Global
 {
@@ -15,6 +17,8 @@ namespace Global
         Sound::SoundService* sound_service;
         UI::UIService* ui_service;
         Gameplay::GameplayService* gameplay_service;
+        Task::TaskService* task_service;
+        Asset::AssetService* asset_service;
 
         ServiceLocator();
         ~ServiceLocator();
@@ -34,6 +38,8 @@ namespace Global
         Sound::SoundService* getSoundService();
         UI::UIService* getUIService();
         Gameplay::GameplayService* getGameplayService();
+        Task::TaskService* getTaskService();
+        Asset::AssetService* getAssetService();
         
     };
 }
\ No newline at end of file
@@ -0,0 +1,13 @@
+#pragma once
+#include <thread>
+
+namespace Global
+{
+	// Pins worker threads to a single core, so concurrent sorts do not migrate between cores or share one.
+	class ThreadAffinity
+	{
+	public:
+		static int getCoreCount();
+		static bool pinToCore(std::thread& thread, int core);
+	};
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <cstdio>
+
+namespace Graphics
+{
+	enum class FrameExportFormat
+	{
+		PNG_SEQUENCE,
+		RAW_STREAM,
+	};
+
+	// Encodes captured frames on the task pool while the game loop produces the next one. At most
+	// max_encoder_tasks tasks drain the queue at a time: one for a raw stream, which has to stay in frame order.
+	class FrameExporter
+	{
+	private:
+		struct Frame
+		{
+			int index;
+			sf::Vector2u size;
+			std::vector<sf::Uint8> pixels;
+		};
+
+		// Enough to keep every encoder busy without holding seconds of 1080p frames in memory.
+		const int max_pending_frames_per_encoder = 2;
+
+		FrameExportFormat export_format;
+		std::string output_path;
+		std::FILE* raw_stream;
+
+		int max_encoder_tasks;
+		int running_encoder_tasks;
+		std::deque<Frame> pending_frames;
+		std::mutex frame_mutex;
+		std::condition_variable frame_condition;
+
+		int next_frame_index;
+		int exported_frame_count;
+		bool stopping;
+
+		bool openRawStream();
+		void processFrames();
+		void encodeFrame(Frame& frame);
+		void writePngFrame(Frame& frame);
+		void writeRawFrame(Frame& frame);
+		std::string getFramePath(int frame_index);
+
+	public:
+		FrameExporter();
+		~FrameExporter();
+
+		bool initialize(FrameExportFormat format, const std::string& path);
+		void submitFrame(const sf::Image& frame_image);
+		void finish();
+
+		int getExportedFrameCount();
+	};
+}
@@ -1,12 +1,23 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include "Graphics/FrameExporter.h"
 
 namespace Graphics
 {
+	enum class RenderMode
+	{
+		WINDOWED,
+		WINDOWED_OFFSCREEN, // drawn into a texture at the reference resolution that the window shows scaled, so
+		                    // exported frames keep their size however the window is resized
+		HEADLESS,
+	};
+
 	class GraphicService
 	{
 	private:
-		const int frame_rate = 60;
+		// Frame pacing only: a frame rate limit (0 for none) or vsync. Playback runs on simulated time either way.
+		int frame_rate_limit;
+		bool vertical_sync;
 
 		const std::string game_window_title = "Outscal Presents - Sorting Sticks";
 
@@ -14,14 +25,33 @@ namespace Graphics
 		const int game_window_height = 1080;
 		sf::Vector2f reference_resolution;
 
+		// Maps the reference resolution onto the whole target, so everything is laid out in reference coordinates.
+		sf::View reference_view;
+
 		const sf::Color window_color = sf::Color(200, 200, 0, 255);
 
+		// Frames are only drawn when something asked for it (or once per idle_redraw_interval as a safety net); an
+		// unchanged frame is skipped instead of redrawn. Headless runs and exports draw every frame.
+		const sf::Time idle_redraw_interval = sf::seconds(1.f);
+		const sf::Time uncapped_idle_frame_time = sf::milliseconds(16);
+		bool redraw_requested;
+		sf::Clock idle_clock;
+
+		RenderMode render_mode;
+		bool headless_running;
+
 		sf::VideoMode video_mode;
 		sf::RenderWindow* game_window;
+		sf::RenderTexture* render_texture;
+		sf::RenderTarget* render_target;
+		FrameExporter* frame_exporter;
 
 		void setReferenceResolution();
+		void applyReferenceView();
 
 		void configureVideoMode();
+		void presentRenderTexture();
+		void applyFramePacing();
 		void onDestroy();
 
 	public:
@@ -29,13 +59,30 @@ namespace Graphics
 		~GraphicService();
 
 		sf::RenderWindow* createGameWindow();
+		sf::RenderTexture* createRenderTexture();
 
 		void initialize();
 		void update();
 		void render();
+		void display();
+		void requestRedraw();
+		bool isRedrawNeeded();
+		void skipFrame();
 		bool isGameWindowOpen();
+		void closeGameWindow();
 		void setFrameRate(int);
+		void setFramePacing(int frame_rate_limit, bool vertical_sync);
+		void onGameWindowResized(unsigned int width, unsigned int height);
+
+		void setRenderMode(RenderMode mode);
+		bool isHeadless();
+		sf::Image captureFrame();
+
+		bool startFrameExport(FrameExportFormat format, const std::string& path);
+		void stopFrameExport();
+
 		sf::Vector2f getReferenceResolution();
 		sf::RenderWindow* getGameWindow();
+		sf::RenderTarget* getRenderTarget();
 	};
-}
\ No newline at end of file
+}
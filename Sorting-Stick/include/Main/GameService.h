@@ -1,6 +1,7 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include "Global/ServiceLocator.h"
+#include "Main/LaunchOptions.h"
 
 namespace Main
 {
@@ -10,6 +11,8 @@ namespace Main
 		SPLASH_SCREEN,
 		MAIN_MENU,
 		GAMEPLAY,
+		RACE,
+		EXTERNAL_SORT,
 	};
 
 	class GameService
@@ -17,16 +20,34 @@ namespace Main
 	private:
 		static GameState current_state;
 
+		LaunchOptions launch_options;
 		Global::ServiceLocator* service_locator;
-		sf::RenderWindow* game_window;
+		sf::RenderTarget* render_target;
+
+		// The simulation advances in fixed steps of simulated time, however often frames are rendered.
+		const double simulation_step_milliseconds = 1000.0 / 120.0;
+		const double max_frame_milliseconds = 250.0;
+		sf::Clock frame_clock;
+		double simulation_accumulator;
 
 		void initialize();
 		void initializeVariables();
 		void showSplashScreen();
+		void waitForAssets();
+		void startHeadlessSort();
+		void startRace();
+		void startExternalSort();
+		void startFrameExport();
+		void startLogPlayback();
+		void runMergeBenchmark();
+		void buildAssetPack();
+		void loadDataset();
+		void processHeadlessState();
+		void advanceSimulation();
 		void destroy();
 
 	public:
-		GameService();
+		GameService(LaunchOptions options = LaunchOptions());
 		virtual ~GameService();
 
 		void ignite();
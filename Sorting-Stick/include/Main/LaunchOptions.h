@@ -0,0 +1,77 @@
+#pragma once
+#include <string>
+#include <cstdint>
+#include "Gameplay/Collection/StickCollectionModel.h"
+#include "Gameplay/Collection/InputGenerator.h"
+#include "Gameplay/Collection/Dataset.h"
+
+namespace Main
+{
+	struct LaunchOptions
+	{
+		// Runs the game loop into an offscreen render texture without opening a window.
+		bool headless = false;
+
+		// Sort started immediately when running headless (there is no menu to click).
+		Gameplay::Collection::SortType sort_type = Gameplay::Collection::SortType::BUBBLE_SORT;
+
+		// Races every sort type side by side instead of running a single sort.
+		bool race = false;
+
+		// Input the sticks are generated from; without a seed every reset draws a new one.
+		Gameplay::Collection::InputDistribution input_distribution = Gameplay::Collection::InputDistribution::SHUFFLED;
+		bool fixed_input_seed = false;
+		std::uint64_t input_seed = 0;
+
+		// Dataset shown (downsampled) instead of generated input; the full set is sorted and saved if a path is given.
+		std::string dataset_path;
+		Gameplay::Collection::DatasetFormat dataset_format = Gameplay::Collection::DatasetFormat::INT32;
+		int csv_column = 0;
+		std::string sorted_dataset_path;
+
+		// Sorts the dataset file into sorted_dataset_path without loading it, using at most memory_budget_mb of RAM.
+		bool external_sort = false;
+		std::size_t memory_budget_mb = 256;
+
+		// Times the k-way merge for k = 2 .. 1024 on benchmark_key_count keys, prints the results and exits.
+		bool benchmark_merge = false;
+		std::size_t benchmark_key_count = 1 << 24;
+
+		// Build step: packs the startup assets into an atlas pack at this path (normally assets/assets.pack) and exits.
+		std::string build_asset_pack_path;
+
+		// Prints memory use, load time and reference count of every asset once loading has finished.
+		bool asset_report = false;
+
+		// Draws the main collection's sticks with one shader pass instead of a shape each, for very large collections.
+		bool shader_sticks = false;
+
+		// Highlighted sticks fade back to the default color after this many frames; 0 keeps them until the sort clears them.
+		int highlight_lifetime_frames = 0;
+
+		// Window frame pacing: a frame rate limit (0 for uncapped) or vsync instead.
+		int frame_rate_limit = 60;
+		bool vertical_sync = false;
+
+		// Optional path the last rendered frame is saved to when the run ends.
+		std::string screenshot_path;
+
+		// Frame export: a directory for a PNG sequence or a file (or "-" for stdout) for raw RGBA frames.
+		std::string export_png_directory;
+		std::string export_raw_path;
+		int export_frame_rate = 60;
+
+		// Operation logs: record every sort to a file, or replay a recorded one starting at an operation index.
+		std::string record_log_path;
+		std::string play_log_path;
+		long long play_log_start_operation = 0;
+
+		bool isExportingFrames() const;
+
+		static LaunchOptions parse(int argc, char* argv[]);
+
+	private:
+		static bool parseSortType(const std::string& name, Gameplay::Collection::SortType& sort_type);
+		static void printUsage();
+	};
+}
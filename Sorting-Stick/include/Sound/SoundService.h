@@ -1,32 +1,77 @@
 #pragma once
 #include "SFML/Audio.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "Task/LockFreeQueue.h"
+#include "Sound/ToneSynthesizer.h"
 
 namespace Sound
 {
 	enum class SoundType
 	{
 		BUTTON_CLICK,
-		COMPARE_SFX,
 	};
 
+	// Compare feedback is synthesized: every compare queues a tone pitched by the value compared (see ToneSynthesizer).
+	// Sound effects are played by an audio thread from a small pool of voices. playSound() only queues a command, from
+	// any thread; the audio thread drains the queue every tick and plays each sound type at most once per retrigger
+	// interval, so however fast the buttons are clicked (or a script calls playSound) the cost stays bounded.
 	class SoundService
 	{
 	private:
+		static const int sound_type_count = 1;
+		static const int voice_count = 8;
+		static const std::size_t command_queue_capacity = 1024;
+
 		const int background_music_volume = 30;
 		const int sound_effect_volume = 200;
+		const std::chrono::milliseconds audio_tick = std::chrono::milliseconds(5);
+		const std::chrono::milliseconds retrigger_intervals[sound_type_count] = {
+			std::chrono::milliseconds(35),  // BUTTON_CLICK
+		};
 
 		sf::Music background_music;
-		sf::Sound sound_effect;
-		sf::SoundBuffer buffer_button_click;
-		sf::SoundBuffer buffer_compare_sfx;
+		ToneSynthesizer tone_synthesizer;
+
+		// Only the audio thread touches the voices. Buffers are looked up on the main thread, where assets load.
+		sf::Sound voices[voice_count];
+		std::chrono::steady_clock::time_point voice_start_times[voice_count];
+		std::chrono::steady_clock::time_point last_play_times[sound_type_count];
+		std::atomic<const sf::SoundBuffer*> sound_buffers[sound_type_count];
+
+		Task::LockFreeQueue<SoundType, command_queue_capacity> command_queue;
+
+		std::thread audio_thread;
+		std::mutex audio_mutex;
+		std::condition_variable audio_condition;
+		bool stopping;
+
+		bool muted = false;
 
 		void loadBackgroundMusicFromFile();
 		void loadSoundFromFile();
+		void resolveSoundBuffers();
+
+		void runAudioThread();
+		void processCommands();
+		void playVoice(SoundType sound_type);
+		sf::Sound& getFreeVoice();
+
+		static const sf::String& getSoundPath(SoundType sound_type);
 
 	public:
+		SoundService();
+		~SoundService();
+
 		void initialize();
+		void update();
+		void destroy();
 
 		void playSound(SoundType soundType);
+		void playTone(float pitch);
 		void playBackgroundMusic();
 	};
-}
\ No newline at end of file
+}
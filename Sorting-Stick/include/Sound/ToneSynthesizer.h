@@ -0,0 +1,54 @@
+#pragma once
+#include "SFML/Audio.hpp"
+#include <vector>
+#include "Task/LockFreeQueue.h"
+
+namespace Sound
+{
+	// Streams short sine tones whose pitch follows the value they were queued with. queueTone() may be called from any
+	// thread; SFML's streaming thread drains the queue once per chunk, starts at most a few of the newest tones and
+	// mixes a fixed number of voices, so the cost per chunk is bounded however many tones are queued.
+	class ToneSynthesizer : public sf::SoundStream
+	{
+	private:
+		struct Tone
+		{
+			double phase = 0.0;
+			double phase_increment = 0.0;
+			float amplitude = 0.f;
+			int remaining_samples = 0;
+		};
+
+		static const unsigned int sample_rate = 44100;
+		static const int chunk_sample_count = 512;          // ~12 ms latency
+		static const int max_tone_count = 32;
+		static const int max_new_tones_per_chunk = 8;
+		static const std::size_t event_queue_capacity = 4096;
+
+		const float min_frequency = 150.f;
+		const float max_frequency = 1500.f;
+		const float tone_duration = 0.06f;
+		const float attack_duration = 0.003f;
+		const float tone_amplitude = 0.35f;
+
+		Task::LockFreeQueue<float, event_queue_capacity> event_queue;
+		Tone tones[max_tone_count];
+		std::vector<sf::Int16> chunk_samples;
+		int tone_sample_count;
+		int attack_sample_count;
+
+		void startQueuedTones();
+		void startTone(float pitch);
+		float mixSample();
+
+		bool onGetData(Chunk& data) override;
+		void onSeek(sf::Time time_offset) override;
+
+	public:
+		ToneSynthesizer();
+		~ToneSynthesizer();
+
+		// pitch in [0, 1] maps exponentially onto min_frequency .. max_frequency.
+		void queueTone(float pitch);
+	};
+}
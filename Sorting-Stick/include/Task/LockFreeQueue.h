@@ -0,0 +1,88 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Task
+{
+	// Bounded queue any number of threads may push to and pop from without locks (Vyukov's ring): every cell carries
+	// a sequence number telling whether it is free to write or ready to read at the current position.
+	// push() fails instead of blocking when the queue is full.
+	template <typename T, std::size_t capacity>
+	class LockFreeQueue
+	{
+	private:
+		static_assert(capacity >= 2 && (capacity & (capacity - 1)) == 0, "capacity must be a power of two");
+
+		struct Cell
+		{
+			std::atomic<std::size_t> sequence;
+			T value;
+		};
+
+		static const std::size_t cache_line_size = 64;
+
+		Cell cells[capacity];
+		char enqueue_padding[cache_line_size];
+		std::atomic<std::size_t> enqueue_position;
+		char dequeue_padding[cache_line_size];
+		std::atomic<std::size_t> dequeue_position;
+
+	public:
+		LockFreeQueue()
+		{
+			for (std::size_t i = 0; i < capacity; i++) cells[i].sequence.store(i, std::memory_order_relaxed);
+			enqueue_position.store(0, std::memory_order_relaxed);
+			dequeue_position.store(0, std::memory_order_relaxed);
+		}
+
+		LockFreeQueue(const LockFreeQueue&) = delete;
+		LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+
+		bool push(const T& value)
+		{
+			std::size_t position = enqueue_position.load(std::memory_order_relaxed);
+			Cell* cell;
+
+			while (true)
+			{
+				cell = &cells[position & (capacity - 1)];
+				std::intptr_t difference = static_cast<std::intptr_t>(cell->sequence.load(std::memory_order_acquire)) - static_cast<std::intptr_t>(position);
+
+				if (difference == 0)
+				{
+					if (enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+				}
+				else if (difference < 0) return false;
+				else position = enqueue_position.load(std::memory_order_relaxed);
+			}
+
+			cell->value = value;
+			cell->sequence.store(position + 1, std::memory_order_release);
+			return true;
+		}
+
+		bool pop(T& value)
+		{
+			std::size_t position = dequeue_position.load(std::memory_order_relaxed);
+			Cell* cell;
+
+			while (true)
+			{
+				cell = &cells[position & (capacity - 1)];
+				std::intptr_t difference = static_cast<std::intptr_t>(cell->sequence.load(std::memory_order_acquire)) - static_cast<std::intptr_t>(position + 1);
+
+				if (difference == 0)
+				{
+					if (dequeue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+				}
+				else if (difference < 0) return false;
+				else position = dequeue_position.load(std::memory_order_relaxed);
+			}
+
+			value = cell->value;
+			cell->sequence.store(position + capacity, std::memory_order_release);
+			return true;
+		}
+	};
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Task
+{
+	enum class TaskPriority
+	{
+		HIGH,   // short and waited on, e.g. chunks of a parallel loop or assets the next frame needs
+		NORMAL,
+		LOW,    // long running work such as whole sorts, picked up only when nothing else is queued
+	};
+
+	// Counts the tasks submitted with it; TaskService::wait() joins them.
+	class TaskGroup
+	{
+	private:
+		friend class TaskService;
+
+		std::atomic<int> pending_tasks;
+		std::mutex group_mutex;
+		std::condition_variable group_condition;
+
+		void addTask();
+		void finishTask();
+
+	public:
+		TaskGroup();
+
+		bool isIdle();
+	};
+
+	// Fixed pool of worker threads, one per core but the main thread's, shared by everything that runs in the background.
+	// Each worker keeps its own deque: tasks it forks go to the back and are taken from there again (LIFO, still
+	// in cache), idle workers steal from the front of the others. Tasks submitted from outside the pool go to
+	// one shared queue per priority.
+	class TaskService
+	{
+	private:
+		struct QueuedTask
+		{
+			std::function<void()> function;
+			TaskGroup* group;
+		};
+
+		struct Worker
+		{
+			std::thread thread;
+			std::mutex queue_mutex;
+			std::deque<QueuedTask> tasks;
+		};
+
+		const int min_worker_count = 2;
+		const int chunks_per_worker = 4; // parallelFor splits finer than the worker count to even out the load
+
+		std::vector<std::unique_ptr<Worker>> workers;
+		std::deque<QueuedTask> shared_queues[3];
+		std::mutex shared_queue_mutex;
+		std::condition_variable work_condition;
+		std::atomic<int> queued_task_count;
+		bool stopping;
+
+		void runWorker(int worker_index);
+		bool takeTask(int worker_index, QueuedTask& task, bool take_low_priority = true);
+		bool takeSharedTask(TaskPriority priority, QueuedTask& task);
+		bool stealTask(int worker_index, QueuedTask& task);
+		void executeTask(QueuedTask& task);
+		void notifyWorkers();
+
+		static int getCurrentWorkerIndex();
+
+	public:
+		TaskService();
+		~TaskService();
+
+		void initialize();
+		void destroy();
+
+		void submit(std::function<void()> function, TaskPriority priority = TaskPriority::NORMAL, TaskGroup* group = nullptr);
+
+		// Blocks until every task of the group has run. Called on a worker it runs queued HIGH and NORMAL tasks
+		// meanwhile, so recursive fork/join never runs out of threads; it never starts a LOW one (a whole sort).
+		void wait(TaskGroup& group);
+
+		// Calls body(begin, end) over chunks of [0, count) no smaller than min_chunk_size. The calling thread takes
+		// chunks as well, so it finishes even when every worker is busy with something long running.
+		void parallelFor(std::size_t count, std::size_t min_chunk_size, const std::function<void(std::size_t, std::size_t)>& body);
+
+		int getWorkerCount();
+	};
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include "UI/Interface/IUIController.h"
+#include "UI/UIElement/TextView.h"
+#include "UI/UIElement/ButtonView.h"
+#include "Gameplay/Collection/ExternalSorter.h"
+
+namespace UI
+{
+	namespace ExternalSortUI
+	{
+		class ExternalSortUIController : public Interface::IUIController
+		{
+		private:
+			const float title_font_size = 40.f;
+			const float status_font_size = 26.f;
+
+			const float title_text_x_position = 60.f;
+			const float title_text_y_position = 36.f;
+			const float status_text_x_position = 60.f;
+			const float status_text_y_position = 104.f;
+			const float output_label_y_position = 1000.f;
+
+			const float menu_button_x_position = 1770.f;
+			const float menu_button_y_position = 33.f;
+			const float button_width = 100.f;
+			const float button_height = 50.f;
+
+			UIElement::TextView* title_text;
+			UIElement::TextView* status_text;
+			UIElement::TextView* output_label_text;
+			UIElement::ButtonView* menu_button;
+
+			void createButton();
+			void createTexts();
+			void initializeButton();
+			void initializeTexts();
+
+			void updateStatusText();
+			sf::String getStatusString(const Gameplay::Collection::ExternalSortProgress& progress);
+			void menuButtonCallback();
+			void registerButtonCallback();
+
+			void destroy();
+
+		public:
+			ExternalSortUIController();
+			~ExternalSortUIController();
+
+			void initialize() override;
+			void update() override;
+			void render() override;
+			void show() override;
+		};
+	}
+}
@@ -1,8 +1,12 @@
 #pragma once
 #include "UI/Interface/IUIController.h"
 #include "UI/UIElement/TextView.h"
+#include "UI/UIElement/TextBatchView.h"
 #include "UI/UIElement/ButtonView.h"
 #include "UI/UIElement/ImageView.h"
+#include "UI/UIElement/TextButtonView.h"
+#include "UI/UIElement/SliderView.h"
+#include "Gameplay/Collection/StickCollectionModel.h"
 
 namespace UI
 {
@@ -32,18 +36,57 @@ namespace UI
 			const float image_width = 50.f;
 			const float image_height = 50.f;
 
-			UIElement::TextView* search_type_text;
-			UIElement::TextView* comparisons_text;
-			UIElement::TextView* array_access_text;
-			UIElement::TextView* num_sticks_text;
-			UIElement::TextView* delay_text;
-			UIElement::TextView* time_complexity_text;
+			const float timeline_y_position = 1032.f;
+			const float timeline_button_height = 40.f;
+			const float timeline_font_size = 28.f;
+			const float step_back_button_x_position = 60.f;
+			const float reverse_button_x_position = 140.f;
+			const float play_button_x_position = 290.f;
+			const float step_forward_button_x_position = 420.f;
+			const float step_button_width = 70.f;
+			const float toggle_button_width = 140.f;
+			const float play_button_width = 120.f;
+			const float timeline_slider_x_position = 520.f;
+			const float timeline_slider_y_position = 1044.f;
+			const float timeline_slider_width = 1040.f;
+			const float timeline_slider_height = 16.f;
+			const float timeline_text_x_position = 1590.f;
+
+			const sf::Color timeline_button_color = sf::Color(40, 40, 40);
+			const sf::Color timeline_track_color = sf::Color(70, 70, 70);
+			const sf::Color timeline_fill_color = sf::Color(0, 170, 255);
+
+			// The counters change almost every frame while a sort plays, so the HUD lines share one batch and are only
+			// reformatted when their value changes.
+			UIElement::TextBatchView* hud_texts;
+			int search_type_text;
+			int comparisons_text;
+			int array_access_text;
+			int num_sticks_text;
+			int delay_text;
+			int time_complexity_text;
+			Gameplay::Collection::SortType shown_sort_type;
+			bool sort_type_shown;
 			UIElement::ButtonView* menu_button;
 
+			UIElement::TextButtonView* step_back_button;
+			UIElement::TextButtonView* reverse_button;
+			UIElement::TextButtonView* play_button;
+			UIElement::TextButtonView* step_forward_button;
+			UIElement::SliderView* timeline_slider;
+			UIElement::TextBatchView* timeline_texts;
+			int timeline_text;
+			long long shown_operation_index;
+			long long shown_operation_count;
+			bool shown_playback_reversed;
+			bool shown_playback_paused;
+
 			void createButton();
 			void createTexts();
+			void createTimelineControls();
 			void initializeButton();
 			void initializeTexts();
+			void initializeTimelineControls();
 
 			void updateSearchTypeText();
 			void updateComparisonsText();
@@ -51,7 +94,13 @@ namespace UI
 			void updateNumberOfSticksText();
 			void updateDelayText();
 			void updateTimeComplexityText();
+			void updateTimelineControls();
 			void menuButtonCallback();
+			void stepBackButtonCallback();
+			void reverseButtonCallback();
+			void playButtonCallback();
+			void stepForwardButtonCallback();
+			void timelineSliderCallback(float value);
 			void registerButtonCallback();
 
 			void destroy();
@@ -3,6 +3,7 @@
 #include "UI/Interface/IUIController.h"
 #include "UI/UIElement/ImageView.h"
 #include "UI/UIElement/ButtonView.h"
+#include "UI/UIElement/TextButtonView.h"
 
 namespace UI
 {
@@ -28,6 +29,30 @@ namespace UI
 			const float radix_sort_button_y_position = 600.f;
 			const float quit_button_y_position = 830.f;
 
+			// Race has no button texture, so it is drawn as a labelled rectangle below the sort buttons.
+			const float race_button_x_position = 820.f;
+			const float race_button_y_position = 740.f;
+			const float race_button_width = 280.f;
+			const float race_button_height = 60.f;
+			const float race_button_font_size = 40.f;
+			const sf::Color race_button_color = sf::Color(200, 60, 60);
+
+			// Cycles the input distribution, drawn the same way to the left of the race button.
+			const float input_button_x_position = 420.f;
+			const float input_button_y_position = 740.f;
+			const float input_button_width = 360.f;
+			const float input_button_height = 60.f;
+			const float input_button_font_size = 32.f;
+			const sf::Color input_button_color = sf::Color(60, 110, 200);
+
+			// Multiway merge sort has no button texture either, it sits to the right of the race button.
+			const float multiway_merge_sort_button_x_position = 1140.f;
+			const float multiway_merge_sort_button_y_position = 740.f;
+			const float multiway_merge_sort_button_width = 360.f;
+			const float multiway_merge_sort_button_height = 60.f;
+			const float multiway_merge_sort_button_font_size = 32.f;
+			const sf::Color multiway_merge_sort_button_color = sf::Color(60, 160, 90);
+
 			// References:
 			UIElement::ImageView* background_image;
 			UIElement::ButtonView* bubble_sort_button;
@@ -37,6 +62,9 @@ namespace UI
 			UIElement::ButtonView* quick_sort_button;
 			UIElement::ButtonView* radix_sort_button;
 			UIElement::ButtonView* quit_button;
+			UIElement::TextButtonView* race_button;
+			UIElement::TextButtonView* input_button;
+			UIElement::TextButtonView* multiway_merge_sort_button;
 
 			const float background_alpha = 85.f;
 
@@ -52,6 +80,10 @@ namespace UI
 			void mergeSortButtonCallback();
 			void quickSortButtonCallback();
 			void radixSortButtonCallback();
+			void raceButtonCallback();
+			void multiwayMergeSortButtonCallback();
+			void inputButtonCallback();
+			sf::String getInputButtonLabel();
 			void quitButtonCallback();
 
 			void destroy();
@@ -0,0 +1,66 @@
+#pragma once
+#include <vector>
+#include "UI/Interface/IUIController.h"
+#include "UI/UIElement/TextView.h"
+#include "UI/UIElement/ButtonView.h"
+#include "Gameplay/Collection/StickCollectionModel.h"
+#include "Gameplay/Collection/SortVerifier.h"
+
+namespace Gameplay
+{
+	class RaceController;
+}
+
+namespace UI
+{
+	namespace RaceUI
+	{
+		class RaceUIController : public Interface::IUIController
+		{
+		private:
+			const float title_font_size = 40.f;
+			const float cell_font_size = 26.f;
+			const int max_race_cells = 9;
+
+			const float title_text_x_position = 60.f;
+			const float title_text_y_position = 36.f;
+			const float cell_text_x_offset = 30.f;
+			const float cell_name_text_y_offset = 4.f;
+			const float cell_counter_text_y_offset = 34.f;
+
+			const float menu_button_x_position = 1770.f;
+			const float menu_button_y_position = 33.f;
+			const float button_width = 100.f;
+			const float button_height = 50.f;
+
+			UIElement::TextView* title_text;
+			std::vector<UIElement::TextView*> name_texts;
+			std::vector<UIElement::TextView*> counter_texts;
+			UIElement::ButtonView* menu_button;
+			int laid_out_cell_count;
+
+			void createButton();
+			void createTexts();
+			void initializeButton();
+			void initializeTexts();
+
+			void updateCellTexts();
+			void layoutCellTexts(Gameplay::RaceController* race_controller, int cell_count);
+			sf::String getSortTypeName(Gameplay::Collection::SortType sort_type);
+			sf::String getVerificationLabel(const Gameplay::Collection::SortVerification& verification);
+			void menuButtonCallback();
+			void registerButtonCallback();
+
+			void destroy();
+
+		public:
+			RaceUIController();
+			~RaceUIController();
+
+			void initialize() override;
+			void update() override;
+			void render() override;
+			void show() override;
+		};
+	}
+}
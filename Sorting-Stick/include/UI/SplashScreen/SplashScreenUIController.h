@@ -1,6 +1,7 @@
 #pragma once
 #include "UI/Interface/IUIController.h"
 #include "UI/UIElement/AnimatedImageView.h"
+#include "UI/UIElement/RectangleShapeView.h"
 
 namespace UI
 {
@@ -13,10 +14,18 @@ namespace UI
 			const float logo_animation_duration = 2.0f;
 			const float logo_width = 600.f;
 			const float logo_height = 134.f;
+			const float loading_bar_height = 8.f;
+			const float loading_bar_spacing = 60.f;
+			const sf::Color loading_bar_background_color = sf::Color(255, 255, 255, 40);
+			const sf::Color loading_bar_color = sf::Color(255, 255, 255, 200);
 
 			UIElement::AnimatedImageView* outscal_logo_view;
+			UIElement::RectangleShapeView* loading_bar_background;
+			UIElement::RectangleShapeView* loading_bar;
 
 			void initializeOutscalLogo();
+			void initializeLoadingBar();
+			void updateLoadingBar();
 			void fadeInAnimationCallback();
 			void fadeOutAnimationCallback();
 			sf::Vector2f getLogoPosition();
@@ -1,12 +1,14 @@
 #pragma once
 #include "UI/UIElement/ImageView.h"
+#include "Event/InputDispatcher.h"
 #include <functional>
 
 namespace UI
 {
 	namespace UIElement
 	{
-		class ButtonView : public ImageView
+		// Clicks arrive through the InputDispatcher; the button only stamps itself as active while it is updated.
+		class ButtonView : public ImageView, public Event::IInputHandler
 		{
 		private:
 			// Define a function pointer type for the callback function
@@ -15,13 +17,15 @@ namespace UI
 			// Store the callback function
 			CallbackFunction callback_function = nullptr;
 
+			Event::InputDispatcher* input_dispatcher;
+			unsigned long long input_frame;
+
 			void printButtonClicked();
 
 		protected:
 			sf::String button_title;
 
-			virtual void handleButtonInteraction();
-			virtual bool clickedButton(sf::Sprite* button_sprite, sf::Vector2f mouse_position);
+			virtual void onBoundsChanged() override;
 
 		public:
 			ButtonView();
@@ -32,6 +36,10 @@ namespace UI
 			virtual void render() override;
 
 			void registerCallbackFuntion(CallbackFunction button_callback);
+
+			virtual bool isAcceptingInput() override;
+			virtual sf::FloatRect getInputBounds() override;
+			virtual void onMousePressed(sf::Vector2f position) override;
 		};
 	}
 }
\ No newline at end of file
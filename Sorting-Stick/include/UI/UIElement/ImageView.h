@@ -5,12 +5,22 @@ namespace UI
 {
 	namespace UIElement
 	{
+		// The texture is shared through the AssetService and may still be loading; size, origin and alignment are
+		// kept and applied once it is bound.
 		class ImageView : public UIView
 		{
 		protected:
-			sf::Texture image_texture;
+			std::string image_texture_path;
+			bool texture_bound;
+			sf::Vector2f image_size;
+			bool origin_at_centre;
+			bool centre_aligned;
 			sf::Sprite image_sprite;
 
+			void bindTexture();
+			void applyScale();
+			void applyCentreAlignment();
+
 		public:
 			ImageView();
 			virtual ~ImageView();
@@ -25,6 +25,7 @@ namespace UI
 			virtual void setOutlineThickness(int outline_thikness);
 
 			sf::Vector2f getSize();
+			sf::FloatRect getGlobalBounds();
 		};
 	}
 }
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+#include "UI/UIElement/RectangleShapeView.h"
+#include "Event/InputDispatcher.h"
+#include <functional>
+
+namespace UI
+{
+	namespace UIElement
+	{
+		// Horizontal bar showing a value between 0 and 1, which can be dragged with the mouse.
+		class SliderView : public RectangleShapeView, public Event::IInputHandler
+		{
+		private:
+			using CallbackFunction = std::function<void(float)>;
+
+			CallbackFunction callback_function = nullptr;
+
+			RectangleShapeView* fill_view;
+			sf::Vector2f slider_size;
+			sf::Vector2f slider_position;
+			float value;
+			bool dragging;
+
+			Event::InputDispatcher* input_dispatcher;
+			unsigned long long input_frame;
+
+			void dragTo(sf::Vector2f position);
+
+		protected:
+			virtual void onBoundsChanged() override;
+
+		public:
+			SliderView();
+			virtual ~SliderView();
+
+			virtual void initialize(sf::Vector2f size, sf::Vector2f position, sf::Color track_color, sf::Color fill_color);
+			virtual void update() override;
+			virtual void render() override;
+			virtual void show() override;
+			virtual void hide() override;
+
+			void setValue(float new_value);
+			float getValue();
+			bool isDragging();
+
+			// Called with the new value while the slider is dragged.
+			void registerCallbackFuntion(CallbackFunction slider_callback);
+
+			virtual bool isAcceptingInput() override;
+			virtual sf::FloatRect getInputBounds() override;
+			virtual void onMousePressed(sf::Vector2f position) override;
+			virtual void onMouseDragged(sf::Vector2f position) override;
+			virtual void onMouseReleased(sf::Vector2f position) override;
+		};
+	}
+}
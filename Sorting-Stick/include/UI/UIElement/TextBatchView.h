@@ -0,0 +1,56 @@
+#pragma once
+#include "UI/UIElement/TextView.h"
+#include <vector>
+
+namespace UI
+{
+	namespace UIElement
+	{
+		// Several lines of text in one font and size, drawn with a single vertex array. Lines keep their text in a fixed
+		// buffer and the glyph quads are rebuilt only when one of them changes, without allocating once warmed up.
+		class TextBatchView : public UIView
+		{
+		private:
+			static const int max_text_length = 63;
+
+			struct BatchedText
+			{
+				sf::Vector2f position;  // reference resolution
+				char text[max_text_length + 1];
+				long long value;
+				bool has_value;
+			};
+
+			const sf::Font* font;
+			unsigned int character_size;
+			sf::Color text_color;
+
+			std::vector<BatchedText> texts;
+			sf::VertexArray vertices;
+			bool geometry_dirty;
+
+			// A font that finishes loading (or is reloaded) starts a new glyph page, the geometry is then rebuilt.
+			const sf::Texture* font_texture;
+			bool font_loaded;
+
+			bool hasFontChanged();
+			void rebuildGeometry();
+			void appendText(const BatchedText& text);
+			void appendGlyph(sf::Vector2f origin, const sf::Glyph& glyph);
+
+		public:
+			TextBatchView();
+			virtual ~TextBatchView();
+
+			virtual void initialize(FontType font_type, int font_size, sf::Color color = sf::Color::White);
+			virtual void update() override;
+			virtual void render() override;
+
+			int addText(const char* text, sf::Vector2f position);
+			void setText(int index, const char* text);
+
+			// Formats label followed by value, only when the value differs from the last one; the label is fixed per line.
+			void setValue(int index, const char* label, long long value);
+		};
+	}
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include "UI/UIElement/RectangleShapeView.h"
+#include "UI/UIElement/TextView.h"
+#include "Event/InputDispatcher.h"
+#include <functional>
+
+namespace UI
+{
+	namespace UIElement
+	{
+		// A plain rectangle with a text label, for controls that have no button texture of their own.
+		class TextButtonView : public RectangleShapeView, public Event::IInputHandler
+		{
+		private:
+			using CallbackFunction = std::function<void()>;
+
+			CallbackFunction callback_function = nullptr;
+
+			const float label_padding = 8.f;
+
+			TextView* label_text;
+
+			Event::InputDispatcher* input_dispatcher;
+			unsigned long long input_frame;
+
+		protected:
+			virtual void onBoundsChanged() override;
+
+		public:
+			TextButtonView();
+			virtual ~TextButtonView();
+
+			virtual void initialize(sf::String label, sf::Vector2f button_size, sf::Vector2f position, int font_size, sf::Color fill_color);
+			virtual void update() override;
+			virtual void render() override;
+			virtual void show() override;
+			virtual void hide() override;
+
+			void setLabel(sf::String label);
+			void registerCallbackFuntion(CallbackFunction button_callback);
+
+			virtual bool isAcceptingInput() override;
+			virtual sf::FloatRect getInputBounds() override;
+			virtual void onMousePressed(sf::Vector2f position) override;
+		};
+	}
+}
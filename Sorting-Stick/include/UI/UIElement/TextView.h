@@ -16,13 +16,8 @@ namespace UI
 		private:
 			static const int default_font_size = 55;
 
-			static sf::Font font_bubble_bobble;
-			static sf::Font font_DS_DIGIB;
-
 			sf::Text text;
 
-			static void loadFont();
-
 			void setFont(FontType font_type);
 			void setFontSize(int font_size);
 			void setTextPosition(sf::Vector2f position);
@@ -32,14 +27,14 @@ namespace UI
 			TextView();
 			virtual ~TextView();
 
-			static void initializeTextView();
-
 			virtual void initialize(sf::String text_value, sf::Vector2f position, FontType font_type = FontType::BUBBLE_BOBBLE, int font_size = default_font_size, sf::Color color = sf::Color::White);
 			virtual void update() override;
 			virtual void render() override;
 
 			void setText(sf::String text_value);
 			void setTextCentreAligned();
+
+			static const sf::Font* getFont(FontType font_type);
 		};
 	}
 }
\ No newline at end of file
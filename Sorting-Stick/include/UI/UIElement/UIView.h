@@ -15,10 +15,14 @@ namespace UI
 		{
 		protected:
 			sf::RenderWindow* game_window;
+			sf::RenderTarget* render_target;
 			UIState ui_state;
 
-			sf::Vector2f getPositionForCurrentResolution(sf::Vector2f position);
-			sf::Vector2f getScaleForCurrentResolution(float width, float height);
+			// Positions and sizes are in reference coordinates; the render target's view scales them to the window.
+			sf::Vector2f reference_resolution;
+
+			// Called after the element moved or changed size.
+			virtual void onBoundsChanged();
 
 		public:
 			UIView();
@@ -2,6 +2,8 @@
 #include "UI/MainMenu/MainMenuUIController.h"
 #include "UI/SplashScreen/SplashScreenUIController.h"
 #include "UI/GameplayUI/GameplayUIController.h"
+#include "UI/RaceUI/RaceUIController.h"
+#include "UI/ExternalSortUI/ExternalSortUIController.h"
 #include "UI/Interface/IUIController.h"
 
 namespace UI
@@ -12,6 +14,8 @@ namespace UI
 		SplashScreen::SplashScreenUIController* splash_screen_controller;
 		MainMenu::MainMenuUIController* main_menu_controller;
 		GameplayUI::GameplayUIController* gameplay_controller;
+		RaceUI::RaceUIController* race_controller;
+		ExternalSortUI::ExternalSortUIController* external_sort_controller;
 
 		void createControllers();
 		void initializeControllers();
@@ -1,10 +1,11 @@
 #include "Main/GameService.h"
+#include "Main/LaunchOptions.h"
 
-int main()
+int main(int argc, char* argv[])
 {
     using namespace Main;
 
-    GameService* game_service = new GameService();
+    GameService* game_service = new GameService(LaunchOptions::parse(argc, argv));
     game_service->ignite();
 
     while (game_service->isRunning())
@@ -14,4 +15,4 @@ int main()
     }
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,327 @@
+#include "Asset/AssetPack.h"
+#include <SFML/Audio.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+
+namespace Asset
+{
+	using namespace Global;
+
+	AssetPack::AssetPack()
+	{
+		header = nullptr;
+		entries = nullptr;
+	}
+
+	bool AssetPack::open(const std::string& path)
+	{
+		close();
+		if (!file.open(path)) return false;
+
+		if (!validate())
+		{
+			fprintf(stderr, "Ignoring invalid asset pack %s\n", path.c_str());
+			close();
+			return false;
+		}
+
+		return true;
+	}
+
+	void AssetPack::close()
+	{
+		file.close();
+		header = nullptr;
+		entries = nullptr;
+	}
+
+	bool AssetPack::isOpen() const
+	{
+		return header != nullptr;
+	}
+
+	// Everything is checked against the file size once, so lookups can trust the offsets afterwards.
+	bool AssetPack::validate()
+	{
+		std::size_t file_size = file.getSize();
+		if (file_size < sizeof(PackHeader)) return false;
+
+		const PackHeader* pack_header = reinterpret_cast<const PackHeader*>(file.getData());
+		if (pack_header->magic != pack_magic || pack_header->version != pack_version) return false;
+
+		std::size_t table_end = sizeof(PackHeader) + static_cast<std::size_t>(pack_header->entry_count) * sizeof(PackEntry);
+		std::uint64_t atlas_bytes = static_cast<std::uint64_t>(pack_header->atlas_width) * pack_header->atlas_height * 4;
+		if (table_end > file_size || pack_header->atlas_offset > file_size || atlas_bytes > file_size - pack_header->atlas_offset) return false;
+
+		const PackEntry* pack_entries = reinterpret_cast<const PackEntry*>(file.getData() + sizeof(PackHeader));
+		for (std::uint32_t i = 0; i < pack_header->entry_count; i++)
+		{
+			const PackEntry& entry = pack_entries[i];
+			if (entry.path[PackEntry::max_path_length] != '\0') return false;
+
+			if (entry.type == static_cast<std::uint32_t>(PackedAssetType::TEXTURE))
+			{
+				if (entry.atlas_x + static_cast<std::uint64_t>(entry.width) > pack_header->atlas_width ||
+					entry.atlas_y + static_cast<std::uint64_t>(entry.height) > pack_header->atlas_height) return false;
+			}
+			else if (entry.data_offset > file_size || entry.data_size > file_size - entry.data_offset) return false;
+		}
+
+		header = pack_header;
+		entries = pack_entries;
+		return true;
+	}
+
+	const PackEntry* AssetPack::findEntry(const std::string& path, PackedAssetType type) const
+	{
+		if (!header) return nullptr;
+
+		for (std::uint32_t i = 0; i < header->entry_count; i++)
+		{
+			if (entries[i].type == static_cast<std::uint32_t>(type) && path == entries[i].path) return &entries[i];
+		}
+		return nullptr;
+	}
+
+	const std::uint8_t* AssetPack::getData(const PackEntry& entry) const
+	{
+		return file.getData() + entry.data_offset;
+	}
+
+	const std::uint8_t* AssetPack::getAtlasPixels() const
+	{
+		return file.getData() + header->atlas_offset;
+	}
+
+	sf::Vector2u AssetPack::getAtlasSize() const
+	{
+		return sf::Vector2u(header->atlas_width, header->atlas_height);
+	}
+
+	bool AssetPack::build(const std::vector<PackSource>& sources, const std::string& path)
+	{
+		std::vector<PackEntry> pack_entries;
+		std::vector<std::vector<char>> entry_data;
+		std::vector<sf::Image> images;
+		std::vector<std::size_t> image_entries;
+
+		for (const PackSource& source : sources)
+		{
+			PackEntry entry;
+			std::memset(&entry, 0, sizeof(entry));
+			entry.type = static_cast<std::uint32_t>(source.type);
+
+			if (source.path.size() > PackEntry::max_path_length)
+			{
+				fprintf(stderr, "Asset path too long for the pack: %s\n", source.path.c_str());
+				return false;
+			}
+			std::memcpy(entry.path, source.path.c_str(), source.path.size());
+
+			std::vector<char> data;
+			switch (source.type)
+			{
+			case PackedAssetType::TEXTURE:
+			{
+				sf::Image image;
+				if (!image.loadFromFile(source.path))
+				{
+					fprintf(stderr, "Error loading texture %s\n", source.path.c_str());
+					return false;
+				}
+				if (source.max_texture_width > 0 && image.getSize().x > source.max_texture_width) image = scaleToWidth(image, source.max_texture_width);
+
+				entry.width = image.getSize().x;
+				entry.height = image.getSize().y;
+				image_entries.push_back(pack_entries.size());
+				images.push_back(image);
+				break;
+			}
+			case PackedAssetType::FONT:
+			{
+				std::ifstream font_file(source.path, std::ios::binary);
+				data.assign(std::istreambuf_iterator<char>(font_file), std::istreambuf_iterator<char>());
+				if (!font_file || data.empty())
+				{
+					fprintf(stderr, "Error loading font %s\n", source.path.c_str());
+					return false;
+				}
+				break;
+			}
+			case PackedAssetType::SOUND:
+			{
+				sf::InputSoundFile sound_file;
+				if (!sound_file.openFromFile(source.path))
+				{
+					fprintf(stderr, "Error loading sound %s\n", source.path.c_str());
+					return false;
+				}
+
+				std::vector<sf::Int16> samples(static_cast<std::size_t>(sound_file.getSampleCount()));
+				samples.resize(static_cast<std::size_t>(sound_file.read(samples.data(), samples.size())));
+
+				entry.channel_count = sound_file.getChannelCount();
+				entry.sample_rate = sound_file.getSampleRate();
+				data.resize(samples.size() * sizeof(sf::Int16));
+				if (!samples.empty()) std::memcpy(data.data(), samples.data(), data.size());
+				break;
+			}
+			}
+
+			pack_entries.push_back(entry);
+			entry_data.push_back(std::move(data));
+		}
+
+		std::vector<sf::Vector2u> positions;
+		unsigned int atlas_height = 0;
+		if (!packAtlas(images, positions, atlas_height))
+		{
+			fprintf(stderr, "Textures do not fit into a %u pixel wide atlas\n", atlas_width);
+			return false;
+		}
+
+		for (std::size_t i = 0; i < images.size(); i++)
+		{
+			pack_entries[image_entries[i]].atlas_x = positions[i].x;
+			pack_entries[image_entries[i]].atlas_y = positions[i].y;
+		}
+
+		PackHeader pack_header;
+		std::memset(&pack_header, 0, sizeof(pack_header));
+		pack_header.magic = pack_magic;
+		pack_header.version = pack_version;
+		pack_header.atlas_width = atlas_width;
+		pack_header.atlas_height = atlas_height;
+		pack_header.entry_count = static_cast<std::uint32_t>(pack_entries.size());
+
+		std::size_t atlas_bytes = static_cast<std::size_t>(atlas_width) * atlas_height * 4;
+		pack_header.atlas_offset = align(sizeof(PackHeader) + pack_entries.size() * sizeof(PackEntry));
+
+		std::size_t pack_size = static_cast<std::size_t>(pack_header.atlas_offset) + atlas_bytes;
+		for (std::size_t i = 0; i < pack_entries.size(); i++)
+		{
+			if (pack_entries[i].type == static_cast<std::uint32_t>(PackedAssetType::TEXTURE)) continue;
+
+			pack_entries[i].data_offset = align(pack_size);
+			pack_entries[i].data_size = entry_data[i].size();
+			pack_size = static_cast<std::size_t>(pack_entries[i].data_offset) + entry_data[i].size();
+		}
+
+		MappedFile pack_file;
+		if (!pack_file.create(path, pack_size))
+		{
+			fprintf(stderr, "Error creating asset pack %s\n", path.c_str());
+			return false;
+		}
+
+		std::uint8_t* pack_data = pack_file.getWritableData();
+		std::memset(pack_data, 0, pack_size);
+		std::memcpy(pack_data, &pack_header, sizeof(pack_header));
+		std::memcpy(pack_data + sizeof(PackHeader), pack_entries.data(), pack_entries.size() * sizeof(PackEntry));
+
+		// Rows of every image are copied straight into place; the padding between them stays transparent.
+		std::uint8_t* atlas_pixels = pack_data + pack_header.atlas_offset;
+		for (std::size_t i = 0; i < images.size(); i++)
+		{
+			sf::Vector2u size = images[i].getSize();
+			for (unsigned int y = 0; y < size.y; y++)
+			{
+				std::memcpy(atlas_pixels + ((static_cast<std::size_t>(positions[i].y) + y) * atlas_width + positions[i].x) * 4,
+					images[i].getPixelsPtr() + static_cast<std::size_t>(y) * size.x * 4, static_cast<std::size_t>(size.x) * 4);
+			}
+		}
+
+		for (std::size_t i = 0; i < pack_entries.size(); i++)
+		{
+			if (!entry_data[i].empty()) std::memcpy(pack_data + pack_entries[i].data_offset, entry_data[i].data(), entry_data[i].size());
+		}
+
+		bool written = pack_file.flush();
+		pack_file.close();
+
+		if (written) printf("Packed %zu assets into %s (%u x %u atlas, %zu bytes)\n", pack_entries.size(), path.c_str(), atlas_width, atlas_height, pack_size);
+		else fprintf(stderr, "Error writing asset pack %s\n", path.c_str());
+		return written;
+	}
+
+	// Shelf packing: images sorted by height fill rows left to right, a new row starts below the tallest of the last one.
+	bool AssetPack::packAtlas(const std::vector<sf::Image>& images, std::vector<sf::Vector2u>& positions, unsigned int& atlas_height)
+	{
+		std::vector<std::size_t> order(images.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(), [&images](std::size_t a, std::size_t b) {
+			return images[a].getSize().y > images[b].getSize().y;
+		});
+
+		positions.assign(images.size(), sf::Vector2u(0, 0));
+		unsigned int x = 0;
+		unsigned int y = 0;
+		unsigned int shelf_height = 0;
+
+		for (std::size_t index : order)
+		{
+			sf::Vector2u size = images[index].getSize();
+			if (size.x > atlas_width) return false;
+
+			if (x + size.x > atlas_width)
+			{
+				x = 0;
+				y += shelf_height;
+				shelf_height = 0;
+			}
+
+			positions[index] = sf::Vector2u(x, y);
+			x += size.x + atlas_padding;
+			shelf_height = std::max(shelf_height, size.y + atlas_padding);
+		}
+
+		atlas_height = std::max(1u, y + shelf_height);
+		return true;
+	}
+
+	// Box filter: every target pixel averages the block of source pixels it covers.
+	sf::Image AssetPack::scaleToWidth(const sf::Image& image, unsigned int width)
+	{
+		sf::Vector2u source_size = image.getSize();
+		unsigned int height = std::max(1u, static_cast<unsigned int>((static_cast<std::uint64_t>(source_size.y) * width + source_size.x / 2) / source_size.x));
+
+		sf::Image scaled;
+		scaled.create(width, height);
+		const sf::Uint8* source_pixels = image.getPixelsPtr();
+
+		for (unsigned int y = 0; y < height; y++)
+		{
+			unsigned int source_top = static_cast<unsigned int>(static_cast<std::uint64_t>(y) * source_size.y / height);
+			unsigned int source_bottom = std::max(source_top + 1, static_cast<unsigned int>(static_cast<std::uint64_t>(y + 1) * source_size.y / height));
+
+			for (unsigned int x = 0; x < width; x++)
+			{
+				unsigned int source_left = static_cast<unsigned int>(static_cast<std::uint64_t>(x) * source_size.x / width);
+				unsigned int source_right = std::max(source_left + 1, static_cast<unsigned int>(static_cast<std::uint64_t>(x + 1) * source_size.x / width));
+
+				unsigned int sums[4] = { 0, 0, 0, 0 };
+				for (unsigned int source_y = source_top; source_y < source_bottom; source_y++)
+				{
+					const sf::Uint8* pixel = source_pixels + (static_cast<std::size_t>(source_y) * source_size.x + source_left) * 4;
+					for (unsigned int source_x = source_left; source_x < source_right; source_x++, pixel += 4)
+					{
+						for (int channel = 0; channel < 4; channel++) sums[channel] += pixel[channel];
+					}
+				}
+
+				unsigned int pixel_count = (source_bottom - source_top) * (source_right - source_left);
+				scaled.setPixel(x, y, sf::Color(sums[0] / pixel_count, sums[1] / pixel_count, sums[2] / pixel_count, sums[3] / pixel_count));
+			}
+		}
+
+		return scaled;
+	}
+
+	std::size_t AssetPack::align(std::size_t offset)
+	{
+		return (offset + data_alignment - 1) / data_alignment * data_alignment;
+	}
+}
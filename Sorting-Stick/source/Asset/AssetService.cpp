@@ -0,0 +1,381 @@
+#include "Asset/AssetService.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include "Global/Config.h"
+#include "Global/ServiceLocator.h"
+
+namespace Asset
+{
+	using namespace Global;
+	using namespace Task;
+
+	namespace
+	{
+		long long getMicrosecondsSince(std::chrono::steady_clock::time_point start_time)
+		{
+			return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time).count();
+		}
+	}
+
+	AssetService::AssetService()
+	{
+		asset_pack_enabled = true;
+		requested_asset_count = 0;
+		uploaded_asset_count = 0;
+		report_pending = false;
+	}
+
+	AssetService::~AssetService() { destroy(); }
+
+	// Everything the menus use is requested up front, so what is not in the pack decodes while the splash screen plays.
+	void AssetService::initialize()
+	{
+		if (asset_pack_enabled) openAssetPack();
+
+		for (const PackSource& source : getStartupAssets())
+		{
+			switch (source.type)
+			{
+			case PackedAssetType::TEXTURE:
+				requestTexture(source.path);
+				break;
+			case PackedAssetType::FONT:
+				requestFont(source.path);
+				break;
+			case PackedAssetType::SOUND:
+				requestSound(source.path);
+				break;
+			}
+		}
+	}
+
+	std::vector<PackSource> AssetService::getStartupAssets()
+	{
+		const unsigned int button_texture_width = 480;
+
+		return {
+			{ PackedAssetType::TEXTURE, Config::outscal_logo_texture_path, 0 },
+			{ PackedAssetType::TEXTURE, Config::background_texture_path, 0 },
+			{ PackedAssetType::TEXTURE, Config::bubble_sort_button_texture_path, button_texture_width },
+			{ PackedAssetType::TEXTURE, Config::insertion_sort_button_texture_path, button_texture_width },
+			{ PackedAssetType::TEXTURE, Config::selection_sort_button_texture_path, button_texture_width },
+			{ PackedAssetType::TEXTURE, Config::merge_sort_button_texture_path, button_texture_width },
+			{ PackedAssetType::TEXTURE, Config::quick_sort_button_texture_path, button_texture_width },
+			{ PackedAssetType::TEXTURE, Config::radix_sort_button_texture_path, button_texture_width },
+			{ PackedAssetType::TEXTURE, Config::quit_button_texture_path, button_texture_width },
+			{ PackedAssetType::TEXTURE, Config::menu_button_large_texture_path, button_texture_width },
+			{ PackedAssetType::FONT, Config::bubble_bobble_font_path, 0 },
+			{ PackedAssetType::FONT, Config::DS_DIGIB_font_path, 0 },
+			{ PackedAssetType::SOUND, Config::button_click_sound_path, 0 },
+		};
+	}
+
+	bool AssetService::buildAssetPack(const std::string& path)
+	{
+		return AssetPack::build(getStartupAssets(), path);
+	}
+
+	void AssetService::setAssetReportEnabled(bool enabled)
+	{
+		report_pending = enabled;
+	}
+
+	void AssetService::setAssetPackEnabled(bool enabled)
+	{
+		asset_pack_enabled = enabled;
+	}
+
+	// A missing pack is not an error, every asset then loads from its own file.
+	void AssetService::openAssetPack()
+	{
+		if (!asset_pack.open(Config::asset_pack_path)) return;
+
+		sf::Vector2u atlas_size = asset_pack.getAtlasSize();
+		if (!atlas_texture.create(atlas_size.x, atlas_size.y))
+		{
+			fprintf(stderr, "Error creating the %u x %u asset atlas\n", atlas_size.x, atlas_size.y);
+			asset_pack.close();
+			return;
+		}
+		atlas_texture.update(asset_pack.getAtlasPixels());
+	}
+
+	void AssetService::update()
+	{
+		uploadDecodedAssets();
+	}
+
+	// Decode tasks write into the assets, so they have to finish before the maps are cleared.
+	void AssetService::destroy()
+	{
+		ServiceLocator::getInstance()->getTaskService()->wait(loading_tasks);
+
+		pending_uploads.clear();
+		textures.clear();
+		fonts.clear();
+		sounds.clear();
+		asset_pack.close();
+	}
+
+	void AssetService::requestTexture(const std::string& path)
+	{
+		getTextureRegion(path);
+	}
+
+	void AssetService::requestSound(const std::string& path)
+	{
+		getSound(path);
+	}
+
+	const sf::Font* AssetService::requestFont(const std::string& path)
+	{
+		std::unique_ptr<FontAsset>& font = fonts[path];
+		if (!font)
+		{
+			font.reset(new FontAsset());
+			startLoading(font.get(), path);
+		}
+
+		return &font->font;
+	}
+
+	const TextureRegion* AssetService::getTextureRegion(const std::string& path)
+	{
+		std::unique_ptr<TextureAsset>& texture = textures[path];
+		if (!texture)
+		{
+			texture.reset(new TextureAsset());
+			startLoading(texture.get(), path);
+		}
+
+		return texture->uploaded && !texture->decode_failed ? &texture->region : nullptr;
+	}
+
+	const sf::SoundBuffer* AssetService::getSound(const std::string& path)
+	{
+		std::unique_ptr<SoundAsset>& sound = sounds[path];
+		if (!sound)
+		{
+			sound.reset(new SoundAsset());
+			startLoading(sound.get(), path);
+		}
+
+		return sound->uploaded && !sound->decode_failed ? &sound->buffer : nullptr;
+	}
+
+	void AssetService::startLoading(LoadedAsset* asset, const std::string& path)
+	{
+		asset->path = path;
+		requested_asset_count++;
+
+		const PackEntry* entry = asset_pack.findEntry(path, asset->getPackedType());
+		if (entry)
+		{
+			std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+			asset->unpack(asset_pack, *entry, atlas_texture);
+			asset->load_microseconds = getMicrosecondsSince(start_time);
+			if (asset->decode_failed) fprintf(stderr, "Error loading asset %s\n", path.c_str());
+			asset->from_pack = true;
+			asset->uploaded = true;
+			uploaded_asset_count++;
+			return;
+		}
+
+		pending_uploads.push_back(asset);
+
+		ServiceLocator::getInstance()->getTaskService()->submit([asset]() {
+			std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+			asset->decode();
+			asset->load_microseconds = getMicrosecondsSince(start_time);
+			asset->decoded.store(true, std::memory_order_release);
+		}, TaskPriority::HIGH, &loading_tasks);
+	}
+
+	void AssetService::uploadDecodedAssets()
+	{
+		for (int i = 0; i < pending_uploads.size();)
+		{
+			LoadedAsset* asset = pending_uploads[i];
+			if (asset->decoded.load(std::memory_order_acquire))
+			{
+				finishLoading(asset);
+				pending_uploads.erase(pending_uploads.begin() + i);
+				ServiceLocator::getInstance()->getGraphicService()->requestRedraw();
+			}
+			else i++;
+		}
+
+		if (report_pending && pending_uploads.empty())
+		{
+			printAssetReport();
+			report_pending = false;
+		}
+	}
+
+	void AssetService::finishLoading(LoadedAsset* asset)
+	{
+		std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+		if (asset->decode_failed) fprintf(stderr, "Error loading asset %s\n", asset->path.c_str());
+		else asset->upload();
+		asset->load_microseconds += getMicrosecondsSince(start_time);
+
+		asset->uploaded = true;
+		uploaded_asset_count++;
+	}
+
+	void AssetService::acquireTexture(const std::string& path)
+	{
+		getTextureRegion(path);
+		textures[path]->reference_count++;
+	}
+
+	// Textures still decoding are kept, their task writes into them.
+	void AssetService::releaseTexture(const std::string& path)
+	{
+		auto texture = textures.find(path);
+		if (texture == textures.end() || texture->second->reference_count == 0) return;
+
+		TextureAsset* asset = texture->second.get();
+		if (--asset->reference_count == 0 && asset->uploaded && !asset->from_pack) textures.erase(texture);
+	}
+
+	void AssetService::printAssetReport()
+	{
+		std::size_t total_bytes = 0;
+		long long total_microseconds = 0;
+
+		printf("%-8s %-48s %-5s %10s %10s %5s\n", "type", "path", "from", "memory KB", "load ms", "refs");
+		for (auto& texture : textures)
+		{
+			printAssetReportLine("texture", *texture.second);
+			total_bytes += texture.second->memory_bytes;
+			total_microseconds += texture.second->load_microseconds;
+		}
+		for (auto& font : fonts)
+		{
+			printAssetReportLine("font", *font.second);
+			total_bytes += font.second->memory_bytes;
+			total_microseconds += font.second->load_microseconds;
+		}
+		for (auto& sound : sounds)
+		{
+			printAssetReportLine("sound", *sound.second);
+			total_bytes += sound.second->memory_bytes;
+			total_microseconds += sound.second->load_microseconds;
+		}
+
+		if (asset_pack.isOpen())
+		{
+			sf::Vector2u atlas_size = asset_pack.getAtlasSize();
+			printf("atlas    %u x %u, %zu KB\n", atlas_size.x, atlas_size.y, static_cast<std::size_t>(atlas_size.x) * atlas_size.y * 4 / 1024);
+		}
+		printf("total    %zu KB, %.3f ms of loading work\n", total_bytes / 1024, total_microseconds / 1000.0);
+	}
+
+	void AssetService::printAssetReportLine(const char* type, const LoadedAsset& asset)
+	{
+		printf("%-8s %-48s %-5s %10zu %10.3f %5d\n", type, asset.path.c_str(), asset.from_pack ? "pack" : "file",
+			asset.memory_bytes / 1024, asset.load_microseconds / 1000.0, asset.reference_count);
+	}
+
+	bool AssetService::isLoading()
+	{
+		return !pending_uploads.empty();
+	}
+
+	float AssetService::getLoadingProgress()
+	{
+		if (requested_asset_count == 0) return 1.f;
+		return static_cast<float>(uploaded_asset_count) / requested_asset_count;
+	}
+
+	void AssetService::waitForAssets()
+	{
+		ServiceLocator::getInstance()->getTaskService()->wait(loading_tasks);
+		uploadDecodedAssets();
+	}
+
+	bool AssetService::readFile(const std::string& path, std::vector<char>& file_data)
+	{
+		std::ifstream file(path, std::ios::binary | std::ios::ate);
+		if (!file) return false;
+
+		std::streamsize size = file.tellg();
+		file.seekg(0, std::ios::beg);
+		file_data.resize(static_cast<std::size_t>(size));
+
+		return size == 0 || static_cast<bool>(file.read(file_data.data(), size));
+	}
+
+	void AssetService::TextureAsset::unpack(const AssetPack& /*pack*/, const PackEntry& entry, const sf::Texture& atlas_texture)
+	{
+		region.texture = &atlas_texture;
+		region.rect = sf::IntRect(entry.atlas_x, entry.atlas_y, entry.width, entry.height);
+		memory_bytes = static_cast<std::size_t>(entry.width) * entry.height * 4;
+	}
+
+	void AssetService::TextureAsset::decode()
+	{
+		std::vector<char> file_data;
+		decode_failed = !readFile(path, file_data) || !image.loadFromMemory(file_data.data(), file_data.size());
+	}
+
+	// The pixels are only needed until they are on the GPU.
+	void AssetService::TextureAsset::upload()
+	{
+		if (!texture.loadFromImage(image)) fprintf(stderr, "Error uploading texture %s\n", path.c_str());
+		image = sf::Image();
+
+		region.texture = &texture;
+		region.rect = sf::IntRect(0, 0, texture.getSize().x, texture.getSize().y);
+		memory_bytes = static_cast<std::size_t>(texture.getSize().x) * texture.getSize().y * 4;
+	}
+
+	void AssetService::FontAsset::unpack(const AssetPack& pack, const PackEntry& entry, const sf::Texture& /*atlas_texture*/)
+	{
+		decode_failed = !font.loadFromMemory(pack.getData(entry), static_cast<std::size_t>(entry.data_size));
+		memory_bytes = static_cast<std::size_t>(entry.data_size);
+	}
+
+	void AssetService::FontAsset::decode()
+	{
+		decode_failed = !readFile(path, file_data);
+	}
+
+	void AssetService::FontAsset::upload()
+	{
+		if (!font.loadFromMemory(file_data.data(), file_data.size())) fprintf(stderr, "Error loading font %s\n", path.c_str());
+		memory_bytes = file_data.size();
+	}
+
+	void AssetService::SoundAsset::unpack(const AssetPack& pack, const PackEntry& entry, const sf::Texture& /*atlas_texture*/)
+	{
+		const sf::Int16* pack_samples = reinterpret_cast<const sf::Int16*>(pack.getData(entry));
+		decode_failed = !buffer.loadFromSamples(pack_samples, entry.data_size / sizeof(sf::Int16), entry.channel_count, entry.sample_rate);
+		memory_bytes = static_cast<std::size_t>(entry.data_size);
+	}
+
+	void AssetService::SoundAsset::decode()
+	{
+		sf::InputSoundFile file;
+		if (!file.openFromFile(path))
+		{
+			decode_failed = true;
+			return;
+		}
+
+		channel_count = file.getChannelCount();
+		sample_rate = file.getSampleRate();
+		samples.resize(static_cast<std::size_t>(file.getSampleCount()));
+		samples.resize(static_cast<std::size_t>(file.read(samples.data(), samples.size())));
+	}
+
+	void AssetService::SoundAsset::upload()
+	{
+		if (!buffer.loadFromSamples(samples.data(), samples.size(), channel_count, sample_rate)) fprintf(stderr, "Error loading sound %s\n", path.c_str());
+		memory_bytes = samples.size() * sizeof(sf::Int16);
+		samples.clear();
+		samples.shrink_to_fit();
+	}
+}
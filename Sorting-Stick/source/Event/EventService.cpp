@@ -8,58 +8,112 @@ namespace Event
     using namespace Global;
     using namespace Graphics;
 
-    EventService::EventService() { game_window = nullptr; }
+    EventService::EventService()
+    {
+        game_window = nullptr;
+        input_dispatcher = new InputDispatcher();
+        left_mouse_button_state = ButtonState::RELEASED;
+        right_mouse_button_state = ButtonState::RELEASED;
+    }
 
-    EventService::~EventService() = default;
+    EventService::~EventService() { delete (input_dispatcher); }
 
     void EventService::initialize()
     {
         game_window = ServiceLocator::getInstance()->getGraphicService()->getGameWindow();
+        input_dispatcher->initialize(ServiceLocator::getInstance()->getGraphicService()->getReferenceResolution());
     }
 
-    void EventService::update()
-    {
-        updateMouseButtonsState(left_mouse_button_state, sf::Mouse::Left);
-        updateMouseButtonsState(right_mouse_button_state, sf::Mouse::Right);
-    }
+    void EventService::update() { }
 
     void EventService::processEvents()
     {
         if (isGameWindowOpen())
         {
+            advanceMouseButtonState(left_mouse_button_state);
+            advanceMouseButtonState(right_mouse_button_state);
+
             // Iterate over all events in the queue.
             while (game_window->pollEvent(game_event))
             {
+                // Hovering changes nothing on screen, only a drag does.
+                if (game_event.type != sf::Event::MouseMoved || heldLeftMouseButton())
+                    ServiceLocator::getInstance()->getGraphicService()->requestRedraw();
+
                 if (gameWindowWasClosed() || hasQuitGame())
                     game_window->close();
+                else if (gameWindowWasResized())
+                    ServiceLocator::getInstance()->getGraphicService()->onGameWindowResized(game_event.size.width, game_event.size.height);
+                else
+                    processMouseEvent();
             }
+
+            input_dispatcher->endFrame();
         }
     }
 
-    void EventService::updateMouseButtonsState(ButtonState& current_button_state, sf::Mouse::Button mouse_button)
+    void EventService::processMouseEvent()
     {
-        if (sf::Mouse::isButtonPressed(mouse_button))
+        switch (game_event.type)
         {
-            switch (current_button_state)
-            {
-            case ButtonState::RELEASED:
-                current_button_state = ButtonState::PRESSED;
-                break;
-            case ButtonState::PRESSED:
-                current_button_state = ButtonState::HELD;
-                break;
-            }
-        }
-        else
-        {
-            current_button_state = ButtonState::RELEASED;
+        case sf::Event::MouseButtonPressed:
+            setMouseButtonState(game_event.mouseButton.button, ButtonState::PRESSED);
+            if (game_event.mouseButton.button == sf::Mouse::Left)
+                input_dispatcher->dispatchMousePressed(getEventPosition(game_event.mouseButton.x, game_event.mouseButton.y));
+            break;
+
+        case sf::Event::MouseButtonReleased:
+            setMouseButtonState(game_event.mouseButton.button, ButtonState::RELEASED);
+            if (game_event.mouseButton.button == sf::Mouse::Left)
+                input_dispatcher->dispatchMouseReleased(getEventPosition(game_event.mouseButton.x, game_event.mouseButton.y));
+            break;
+
+        case sf::Event::MouseMoved:
+            input_dispatcher->dispatchMouseMoved(getEventPosition(game_event.mouseMove.x, game_event.mouseMove.y));
+            break;
+
+        // The release would go to another window, so a drag must not outlive the focus.
+        case sf::Event::LostFocus:
+            releaseMouseButtons();
+            break;
+
+        default:
+            break;
         }
     }
 
+    // A press is reported for one frame, then the button counts as held until its release event.
+    void EventService::advanceMouseButtonState(ButtonState& current_button_state)
+    {
+        if (current_button_state == ButtonState::PRESSED) current_button_state = ButtonState::HELD;
+    }
+
+    void EventService::setMouseButtonState(sf::Mouse::Button mouse_button, ButtonState button_state)
+    {
+        if (mouse_button == sf::Mouse::Left) left_mouse_button_state = button_state;
+        else if (mouse_button == sf::Mouse::Right) right_mouse_button_state = button_state;
+    }
+
+    void EventService::releaseMouseButtons()
+    {
+        left_mouse_button_state = ButtonState::RELEASED;
+        right_mouse_button_state = ButtonState::RELEASED;
+
+        sf::Vector2i mouse_position = sf::Mouse::getPosition(*game_window);
+        input_dispatcher->dispatchMouseReleased(getEventPosition(mouse_position.x, mouse_position.y));
+    }
+
+    sf::Vector2f EventService::getEventPosition(int x_position, int y_position)
+    {
+        return game_window->mapPixelToCoords(sf::Vector2i(x_position, y_position));
+    }
+
     bool EventService::isGameWindowOpen() { return game_window != nullptr; }
 
     bool EventService::gameWindowWasClosed() { return game_event.type == sf::Event::Closed; }
 
+    bool EventService::gameWindowWasResized() { return game_event.type == sf::Event::Resized; }
+
     bool EventService::hasQuitGame() { return (isKeyboardEvent() && pressedEscapeKey()); }
 
     bool EventService::isKeyboardEvent() { return game_event.type == sf::Event::KeyPressed; }
@@ -76,5 +130,9 @@ namespace Event
 
     bool EventService::pressedLeftMouseButton() { return left_mouse_button_state == ButtonState::PRESSED; }
 
+    bool EventService::heldLeftMouseButton() { return left_mouse_button_state != ButtonState::RELEASED; }
+
     bool EventService::pressedRightMouseButton() { return right_mouse_button_state == ButtonState::PRESSED; }
+
+    InputDispatcher* EventService::getInputDispatcher() { return input_dispatcher; }
 }
\ No newline at end of file
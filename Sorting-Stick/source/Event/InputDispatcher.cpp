@@ -0,0 +1,106 @@
+#include "Event/InputDispatcher.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Event
+{
+	InputDispatcher::InputDispatcher()
+	{
+		column_count = 1;
+		row_count = 1;
+		cells_dirty = true;
+		captured_handler = nullptr;
+		frame = 1;  // handlers start with a stamp of 0, which never matches
+	}
+
+	void InputDispatcher::initialize(sf::Vector2f reference_resolution)
+	{
+		column_count = std::max(1, static_cast<int>(std::ceil(reference_resolution.x / cell_size)));
+		row_count = std::max(1, static_cast<int>(std::ceil(reference_resolution.y / cell_size)));
+		cells.assign(column_count * row_count, std::vector<IInputHandler*>());
+		cells_dirty = true;
+	}
+
+	void InputDispatcher::registerHandler(IInputHandler* handler)
+	{
+		handlers.push_back(handler);
+		cells_dirty = true;
+	}
+
+	void InputDispatcher::unregisterHandler(IInputHandler* handler)
+	{
+		handlers.erase(std::remove(handlers.begin(), handlers.end(), handler), handlers.end());
+		if (captured_handler == handler) captured_handler = nullptr;
+		cells_dirty = true;
+	}
+
+	void InputDispatcher::invalidateBounds() { cells_dirty = true; }
+
+	void InputDispatcher::rebuildCells()
+	{
+		for (std::vector<IInputHandler*>& cell : cells) cell.clear();
+		for (IInputHandler* handler : handlers) addToCells(handler);
+		cells_dirty = false;
+	}
+
+	void InputDispatcher::addToCells(IInputHandler* handler)
+	{
+		sf::FloatRect bounds = handler->getInputBounds();
+		if (bounds.width <= 0 || bounds.height <= 0) return;
+
+		int first_column = getColumn(bounds.left);
+		int last_column = getColumn(bounds.left + bounds.width);
+		int first_row = getRow(bounds.top);
+		int last_row = getRow(bounds.top + bounds.height);
+
+		for (int row = first_row; row <= last_row; row++)
+			for (int column = first_column; column <= last_column; column++)
+				cells[row * column_count + column].push_back(handler);
+	}
+
+	int InputDispatcher::getColumn(float x_position)
+	{
+		return std::max(0, std::min(column_count - 1, static_cast<int>(std::floor(x_position / cell_size))));
+	}
+
+	int InputDispatcher::getRow(float y_position)
+	{
+		return std::max(0, std::min(row_count - 1, static_cast<int>(std::floor(y_position / cell_size))));
+	}
+
+	IInputHandler* InputDispatcher::findHandlerAt(sf::Vector2f position)
+	{
+		if (cells_dirty) rebuildCells();
+
+		const std::vector<IInputHandler*>& cell = cells[getRow(position.y) * column_count + getColumn(position.x)];
+		for (auto handler = cell.rbegin(); handler != cell.rend(); ++handler)
+		{
+			if ((*handler)->isAcceptingInput() && (*handler)->getInputBounds().contains(position)) return *handler;
+		}
+
+		return nullptr;
+	}
+
+	void InputDispatcher::dispatchMousePressed(sf::Vector2f position)
+	{
+		captured_handler = findHandlerAt(position);
+		if (captured_handler) captured_handler->onMousePressed(position);
+	}
+
+	void InputDispatcher::dispatchMouseMoved(sf::Vector2f position)
+	{
+		if (captured_handler) captured_handler->onMouseDragged(position);
+	}
+
+	void InputDispatcher::dispatchMouseReleased(sf::Vector2f position)
+	{
+		IInputHandler* handler = captured_handler;
+		captured_handler = nullptr;
+
+		if (handler) handler->onMouseReleased(position);
+	}
+
+	void InputDispatcher::endFrame() { frame++; }
+
+	unsigned long long InputDispatcher::getFrame() { return frame; }
+}
@@ -0,0 +1,260 @@
+#include "Gameplay/Collection/Dataset.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace Gameplay
+{
+	namespace Collection
+	{
+		namespace
+		{
+			template <typename Key>
+			long long sortRange(Key* keys, std::size_t count, SortVerification& verification)
+			{
+				MultisetHash input_hash = SortVerifier::hashKeys(keys, count);
+
+				auto start_time = std::chrono::steady_clock::now();
+				std::sort(keys, keys + count);
+				long long duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time).count();
+
+				verification = SortVerifier::verify(keys, count, input_hash);
+				return duration;
+			}
+
+			template <typename Key>
+			std::vector<int> rankSamples(const Key* keys, std::size_t count, int sample_count)
+			{
+				std::vector<Key> samples;
+				for (int i = 0; i < sample_count; i++) samples.push_back(keys[static_cast<std::size_t>(i) * count / sample_count]);
+
+				std::vector<Key> sorted_samples = samples;
+				std::sort(sorted_samples.begin(), sorted_samples.end());
+
+				std::vector<int> sample_keys;
+				for (Key sample : samples)
+				{
+					sample_keys.push_back(static_cast<int>(std::lower_bound(sorted_samples.begin(), sorted_samples.end(), sample) - sorted_samples.begin()));
+				}
+				return sample_keys;
+			}
+		}
+
+		Dataset::Dataset()
+		{
+			format = DatasetFormat::INT32;
+			key_data = nullptr;
+			key_count = 0;
+			skipped_values = 0;
+		}
+
+		bool Dataset::load(const std::string& path, DatasetFormat format, int csv_column)
+		{
+			this->format = format;
+			key_file.close();
+			csv_keys.clear();
+			key_data = nullptr;
+			key_count = 0;
+			skipped_values = 0;
+
+			bool loaded = format == DatasetFormat::CSV ? loadCsv(path, csv_column) : loadBinary(path);
+			if (!loaded) return false;
+
+			if (skipped_values > 0) fprintf(stderr, "Skipped %zu values in dataset %s\n", skipped_values, path.c_str());
+			if (key_count == 0)
+			{
+				fprintf(stderr, "Dataset %s has no keys\n", path.c_str());
+				return false;
+			}
+			return true;
+		}
+
+		// The mapping starts on a page boundary, so the keys can be used where they are.
+		bool Dataset::loadBinary(const std::string& path)
+		{
+			if (!key_file.openCopyOnWrite(path))
+			{
+				fprintf(stderr, "Error opening dataset %s\n", path.c_str());
+				return false;
+			}
+
+			const std::size_t element_size = getElementSize(format);
+			if (key_file.getSize() % element_size != 0)
+			{
+				fprintf(stderr, "Dataset size %zu is not a multiple of %zu bytes\n", key_file.getSize(), element_size);
+				return false;
+			}
+
+			key_data = key_file.getWritableData();
+			key_count = key_file.getSize() / element_size;
+
+			// Writes (and so copies) only the pages from the first NaN on.
+			if (format == DatasetFormat::FLOAT32)
+			{
+				float* keys = reinterpret_cast<float*>(key_data);
+				float* keys_end = std::remove_if(keys, keys + key_count, [](float key) { return std::isnan(key); });
+				skipped_values = key_count - (keys_end - keys);
+				key_count = keys_end - keys;
+			}
+			return true;
+		}
+
+		bool Dataset::loadCsv(const std::string& path, int column)
+		{
+			Global::MappedFile file;
+			if (!file.open(path))
+			{
+				fprintf(stderr, "Error opening dataset %s\n", path.c_str());
+				return false;
+			}
+
+			const char* cursor = reinterpret_cast<const char*>(file.getData());
+			const char* end = cursor + file.getSize();
+			bool first_line = true;
+
+			while (cursor < end)
+			{
+				for (int field = 0; field < column && cursor < end && *cursor != '\n'; cursor++)
+				{
+					if (*cursor == ',') field++;
+				}
+
+				double value;
+				if (parseNumber(cursor, end, value)) csv_keys.push_back(value);
+				else if (!first_line) skipped_values++; // an unparsable first line is taken as the header
+
+				first_line = false;
+				const char* line_end = static_cast<const char*>(std::memchr(cursor, '\n', end - cursor));
+				cursor = line_end ? line_end + 1 : end;
+			}
+
+			key_data = reinterpret_cast<std::uint8_t*>(csv_keys.data());
+			key_count = csv_keys.size();
+			return true;
+		}
+
+		// Parses [spaces]["][sign]digits[.digits][e[sign]digits], stopping at the end of the field.
+		// Hand rolled because strtod needs a terminated string and consults the locale. Scaling by a power of ten
+		// is not correctly rounded, so a value can end up one ulp away from what strtod would return.
+		bool Dataset::parseNumber(const char*& cursor, const char* end, double& value)
+		{
+			while (cursor < end && (*cursor == ' ' || *cursor == '\t' || *cursor == '"')) cursor++;
+
+			bool negative = false;
+			if (cursor < end && (*cursor == '-' || *cursor == '+')) negative = *cursor++ == '-';
+
+			std::uint64_t mantissa = 0;
+			int exponent = 0;
+			int digit_count = 0;
+
+			for (; cursor < end && *cursor >= '0' && *cursor <= '9'; cursor++, digit_count++)
+			{
+				if (mantissa < 1000000000000000000ull) mantissa = mantissa * 10 + (*cursor - '0');
+				else exponent++;
+			}
+			if (cursor < end && *cursor == '.')
+			{
+				for (cursor++; cursor < end && *cursor >= '0' && *cursor <= '9'; cursor++, digit_count++)
+				{
+					if (mantissa < 1000000000000000000ull)
+					{
+						mantissa = mantissa * 10 + (*cursor - '0');
+						exponent--;
+					}
+				}
+			}
+			if (digit_count == 0) return false;
+
+			if (cursor < end && (*cursor == 'e' || *cursor == 'E'))
+			{
+				cursor++;
+				bool negative_exponent = false;
+				if (cursor < end && (*cursor == '-' || *cursor == '+')) negative_exponent = *cursor++ == '-';
+
+				int written_exponent = 0;
+				for (; cursor < end && *cursor >= '0' && *cursor <= '9'; cursor++)
+				{
+					if (written_exponent < 10000) written_exponent = written_exponent * 10 + (*cursor - '0');
+				}
+				exponent += negative_exponent ? -written_exponent : written_exponent;
+			}
+
+			value = static_cast<double>(mantissa);
+			if (exponent != 0) value *= std::pow(10.0, exponent);
+			if (negative) value = -value;
+			return true;
+		}
+
+		long long Dataset::sortKeys()
+		{
+			switch (format)
+			{
+			case DatasetFormat::INT32:
+				return sortRange(reinterpret_cast<std::int32_t*>(key_data), key_count, sort_verification);
+			case DatasetFormat::FLOAT32:
+				return sortRange(reinterpret_cast<float*>(key_data), key_count, sort_verification);
+			case DatasetFormat::CSV:
+			default:
+				return sortRange(csv_keys.data(), key_count, sort_verification);
+			}
+		}
+
+		const SortVerification& Dataset::getSortVerification()
+		{
+			return sort_verification;
+		}
+
+		bool Dataset::saveKeys(const std::string& path)
+		{
+			const std::size_t element_size = format == DatasetFormat::CSV ? sizeof(double) : getElementSize(format);
+
+			Global::MappedFile file;
+			if (!file.create(path, key_count * element_size))
+			{
+				fprintf(stderr, "Error creating %s\n", path.c_str());
+				return false;
+			}
+
+			std::memcpy(file.getWritableData(), key_data, key_count * element_size);
+			return true;
+		}
+
+		std::vector<int> Dataset::sampleKeys(int count)
+		{
+			switch (format)
+			{
+			case DatasetFormat::INT32:
+				return rankSamples(reinterpret_cast<const std::int32_t*>(key_data), key_count, count);
+			case DatasetFormat::FLOAT32:
+				return rankSamples(reinterpret_cast<const float*>(key_data), key_count, count);
+			case DatasetFormat::CSV:
+			default:
+				return rankSamples(csv_keys.data(), key_count, count);
+			}
+		}
+
+		std::size_t Dataset::getElementSize(DatasetFormat format)
+		{
+			return format == DatasetFormat::INT32 ? sizeof(std::int32_t) : sizeof(float);
+		}
+
+		std::size_t Dataset::getKeyCount() { return key_count; }
+
+		std::size_t Dataset::getSkippedValueCount() { return skipped_values; }
+
+		DatasetFormat Dataset::getFormat() { return format; }
+
+		bool Dataset::parseFormat(const std::string& name, DatasetFormat& format)
+		{
+			if (name == "int32") format = DatasetFormat::INT32;
+			else if (name == "float32") format = DatasetFormat::FLOAT32;
+			else if (name == "csv") format = DatasetFormat::CSV;
+			else return false;
+
+			return true;
+		}
+	}
+}
@@ -0,0 +1,450 @@
+#include "Gameplay/Collection/ExternalSorter.h"
+#include "Gameplay/Collection/LoserTree.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include "Global/ServiceLocator.h"
+
+namespace Gameplay
+{
+	namespace Collection
+	{
+		namespace
+		{
+			// Orders NaNs after every number, so float files containing them still give a strict weak ordering.
+			struct KeyLess
+			{
+				template <typename Key>
+				bool operator()(const Key& first, const Key& second) const { return first < second || (second != second && first == first); }
+			};
+
+			// Reads a run through two blocks: the merge consumes one while the next is read by a task on the pool.
+			// Block I/O is waited on right away, so it goes in at high priority instead of starting a thread per block.
+			template <typename Key>
+			class RunReader
+			{
+			private:
+				std::FILE* file = nullptr;
+				std::uint64_t unrequested_elements = 0;
+				std::vector<Key> buffers[2];
+				int current_buffer = 1;
+				std::size_t position = 0;
+				std::size_t length = 0;
+				Task::TaskGroup read_task;
+				bool read_pending = false;
+				std::size_t read_result = 0; // written by the read task
+				std::size_t pending_elements = 0;
+				std::uint64_t consumed_elements = 0;
+				bool failed = false;
+
+				void requestBlock()
+				{
+					pending_elements = static_cast<std::size_t>(std::min<std::uint64_t>(buffers[0].size(), unrequested_elements));
+					unrequested_elements -= pending_elements;
+
+					std::FILE* read_file = file;
+					Key* destination = buffers[current_buffer ^ 1].data();
+					std::size_t element_count = pending_elements;
+					read_pending = true;
+					Global::ServiceLocator::getInstance()->getTaskService()->submit([this, read_file, destination, element_count]() {
+						read_result = std::fread(destination, sizeof(Key), element_count, read_file);
+					}, Task::TaskPriority::HIGH, &read_task);
+				}
+
+				bool nextBlock()
+				{
+					if (!read_pending) return false;
+
+					Global::ServiceLocator::getInstance()->getTaskService()->wait(read_task);
+					read_pending = false;
+					std::size_t read_elements = read_result;
+					if (read_elements != pending_elements) failed = true;
+
+					consumed_elements += length;
+					current_buffer ^= 1;
+					position = 0;
+					length = read_elements;
+
+					if (unrequested_elements > 0) requestBlock();
+					return length > 0;
+				}
+
+			public:
+				~RunReader() { close(); }
+
+				bool open(const std::string& path, std::uint64_t element_count, std::size_t block_elements)
+				{
+					file = std::fopen(path.c_str(), "rb");
+					if (!file) return false;
+
+					buffers[0].resize(block_elements);
+					buffers[1].resize(block_elements);
+					unrequested_elements = element_count;
+
+					if (unrequested_elements > 0) requestBlock();
+					nextBlock();
+					return true;
+				}
+
+				void close()
+				{
+					if (read_pending) Global::ServiceLocator::getInstance()->getTaskService()->wait(read_task);
+					read_pending = false;
+					if (file) std::fclose(file);
+					file = nullptr;
+				}
+
+				bool hasKey() const { return position < length; }
+				const Key& getKey() const { return buffers[current_buffer][position]; }
+
+				bool advance()
+				{
+					if (++position < length) return true;
+					return nextBlock();
+				}
+
+				std::uint64_t getConsumedElements() const { return consumed_elements + position; }
+				bool hasFailed() const { return failed; }
+			};
+
+			// Fills one block while the previous one is written by a task on the pool.
+			template <typename Key>
+			class RunWriter
+			{
+			private:
+				std::FILE* file = nullptr;
+				std::vector<Key> buffers[2];
+				int current_buffer = 0;
+				std::size_t length = 0;
+				Task::TaskGroup write_task;
+				bool write_pending = false;
+				bool write_result = true; // written by the write task
+				bool failed = false;
+
+				bool waitForWrite()
+				{
+					if (write_pending)
+					{
+						Global::ServiceLocator::getInstance()->getTaskService()->wait(write_task);
+						write_pending = false;
+						if (!write_result) failed = true;
+					}
+					return !failed;
+				}
+
+			public:
+				~RunWriter() { close(); }
+
+				bool open(const std::string& path, std::size_t block_elements)
+				{
+					file = std::fopen(path.c_str(), "wb");
+					if (!file) return false;
+
+					buffers[0].resize(block_elements);
+					buffers[1].resize(block_elements);
+					return true;
+				}
+
+				// Returns true when a block was handed off, which is when the caller updates its progress.
+				bool push(const Key& key)
+				{
+					buffers[current_buffer][length++] = key;
+					if (length < buffers[current_buffer].size()) return false;
+
+					flushBlock();
+					return true;
+				}
+
+				void flushBlock()
+				{
+					waitForWrite();
+					if (length == 0) return;
+
+					std::FILE* write_file = file;
+					const Key* source = buffers[current_buffer].data();
+					std::size_t element_count = length;
+					write_pending = true;
+					Global::ServiceLocator::getInstance()->getTaskService()->submit([this, write_file, source, element_count]() {
+						write_result = std::fwrite(source, sizeof(Key), element_count, write_file) == element_count;
+					}, Task::TaskPriority::HIGH, &write_task);
+
+					current_buffer ^= 1;
+					length = 0;
+				}
+
+				bool close()
+				{
+					if (!file) return !failed;
+
+					flushBlock();
+					waitForWrite();
+					if (std::fclose(file) != 0) failed = true;
+					file = nullptr;
+					return !failed;
+				}
+			};
+
+			std::uint64_t getFileSize(const std::string& path)
+			{
+				std::ifstream file(path, std::ios::binary | std::ios::ate);
+				if (!file) return 0;
+				return static_cast<std::uint64_t>(file.tellg());
+			}
+
+			bool replaceFile(const std::string& source_path, const std::string& destination_path)
+			{
+				std::remove(destination_path.c_str());
+				return std::rename(source_path.c_str(), destination_path.c_str()) == 0;
+			}
+		}
+
+		ExternalSorter::ExternalSorter()
+		{
+			cancelled = false;
+		}
+
+		bool ExternalSorter::sort(const std::string& input_path, const std::string& output_path, DatasetFormat format, std::size_t memory_budget)
+		{
+			{
+				std::lock_guard<std::mutex> lock(progress_mutex);
+				progress = ExternalSortProgress();
+			}
+
+			auto start_time = std::chrono::steady_clock::now();
+			bool sorted = false;
+
+			switch (format)
+			{
+			case DatasetFormat::INT32:
+				sorted = sortFile<std::int32_t>(input_path, output_path, memory_budget);
+				break;
+			case DatasetFormat::FLOAT32:
+				sorted = sortFile<float>(input_path, output_path, memory_budget);
+				break;
+			case DatasetFormat::CSV:
+				fprintf(stderr, "External sort needs a binary int32 or float32 file\n");
+				break;
+			}
+
+			std::lock_guard<std::mutex> lock(progress_mutex);
+			progress.phase = sorted ? ExternalSortPhase::DONE : ExternalSortPhase::FAILED;
+			progress.duration_microseconds = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time).count();
+			return sorted;
+		}
+
+		template <typename Key>
+		bool ExternalSorter::sortFile(const std::string& input_path, const std::string& output_path, std::size_t memory_budget)
+		{
+			std::vector<std::string> run_paths;
+			std::vector<std::uint64_t> run_lengths;
+			if (!formRuns<Key>(input_path, output_path, memory_budget, run_paths, run_lengths)) return false;
+
+			if (run_paths.empty())
+			{
+				std::FILE* empty_file = std::fopen(output_path.c_str(), "wb");
+				if (empty_file) std::fclose(empty_file);
+				return empty_file != nullptr;
+			}
+
+			// Each run in a group needs two blocks, plus two for the output; when that leaves blocks too
+			// small for efficient I/O, fewer runs are merged at once and the merge takes several passes.
+			std::size_t block_bytes = std::min(max_block_bytes, std::max(min_block_bytes, memory_budget / (2 * (run_paths.size() + 1))));
+			std::size_t fan_in = std::max<std::size_t>(3, memory_budget / (2 * block_bytes)) - 1;
+			std::size_t block_elements = block_bytes / sizeof(Key);
+
+			setPhase(ExternalSortPhase::MERGE);
+
+			for (int pass = 1; run_paths.size() > 1; pass++)
+			{
+				std::vector<std::string> merged_paths;
+				std::vector<std::uint64_t> merged_lengths;
+				int group_count = static_cast<int>((run_paths.size() + fan_in - 1) / fan_in);
+
+				for (int group = 0; group < group_count; group++)
+				{
+					std::size_t first_run = group * fan_in;
+					std::size_t last_run = std::min(run_paths.size(), first_run + fan_in);
+					std::vector<std::string> group_paths(run_paths.begin() + first_run, run_paths.begin() + last_run);
+					std::vector<std::uint64_t> group_lengths(run_lengths.begin() + first_run, run_lengths.begin() + last_run);
+					std::string merged_path = group_count == 1 ? output_path : getRunPath(output_path, pass, group);
+
+					{
+						std::lock_guard<std::mutex> lock(progress_mutex);
+						progress.merge_pass = pass;
+						progress.merge_group = group;
+						progress.merge_group_count = group_count;
+						progress.block_elements = block_elements;
+					}
+
+					bool merged = mergeRuns<Key>(group_paths, group_lengths, merged_path, block_elements);
+					for (const std::string& path : group_paths) std::remove(path.c_str());
+					if (!merged)
+					{
+						std::remove(merged_path.c_str());
+						for (std::size_t run = last_run; run < run_paths.size(); run++) std::remove(run_paths[run].c_str());
+						for (const std::string& path : merged_paths) std::remove(path.c_str());
+						return false;
+					}
+
+					merged_paths.push_back(merged_path);
+					std::uint64_t merged_length = 0;
+					for (std::uint64_t length : group_lengths) merged_length += length;
+					merged_lengths.push_back(merged_length);
+				}
+
+				run_paths = merged_paths;
+				run_lengths = merged_lengths;
+			}
+
+			if (run_paths.front() != output_path && !replaceFile(run_paths.front(), output_path))
+			{
+				fprintf(stderr, "Error moving %s to %s\n", run_paths.front().c_str(), output_path.c_str());
+				return false;
+			}
+			return true;
+		}
+
+		template <typename Key>
+		bool ExternalSorter::formRuns(const std::string& input_path, const std::string& output_path, std::size_t memory_budget, std::vector<std::string>& run_paths, std::vector<std::uint64_t>& run_lengths)
+		{
+			std::uint64_t file_size = getFileSize(input_path);
+			if (file_size % sizeof(Key) != 0)
+			{
+				fprintf(stderr, "%s is not a whole number of %zu byte keys\n", input_path.c_str(), sizeof(Key));
+				return false;
+			}
+
+			std::FILE* input_file = std::fopen(input_path.c_str(), "rb");
+			if (!input_file)
+			{
+				fprintf(stderr, "Error opening %s\n", input_path.c_str());
+				return false;
+			}
+
+			std::vector<Key> chunk(std::max<std::size_t>(1, memory_budget / sizeof(Key)));
+			{
+				std::lock_guard<std::mutex> lock(progress_mutex);
+				progress.phase = ExternalSortPhase::RUN_FORMATION;
+				progress.element_count = file_size / sizeof(Key);
+				progress.chunk_elements = chunk.size();
+			}
+
+			bool formed = true;
+			while (formed && !cancelled)
+			{
+				std::size_t chunk_length = std::fread(chunk.data(), sizeof(Key), chunk.size(), input_file);
+				if (chunk_length == 0) break;
+
+				std::sort(chunk.begin(), chunk.begin() + chunk_length, KeyLess());
+
+				std::string run_path = getRunPath(output_path, 0, static_cast<int>(run_paths.size()));
+				std::FILE* run_file = std::fopen(run_path.c_str(), "wb");
+				formed = run_file && std::fwrite(chunk.data(), sizeof(Key), chunk_length, run_file) == chunk_length;
+				if (run_file && std::fclose(run_file) != 0) formed = false;
+				if (!formed) fprintf(stderr, "Error writing run %s\n", run_path.c_str());
+
+				run_paths.push_back(run_path);
+				run_lengths.push_back(chunk_length);
+
+				std::lock_guard<std::mutex> lock(progress_mutex);
+				progress.elements_read += chunk_length;
+				progress.run_lengths.push_back(chunk_length);
+			}
+
+			if (std::ferror(input_file)) formed = false;
+			std::fclose(input_file);
+
+			if (!formed || cancelled)
+			{
+				for (const std::string& path : run_paths) std::remove(path.c_str());
+				return false;
+			}
+			return true;
+		}
+
+		template <typename Key>
+		bool ExternalSorter::mergeRuns(const std::vector<std::string>& run_paths, const std::vector<std::uint64_t>& run_lengths, const std::string& output_path, std::size_t block_elements)
+		{
+			const int run_count = static_cast<int>(run_paths.size());
+			std::vector<RunReader<Key>> readers(run_count);
+			RunWriter<Key> writer;
+
+			for (int run = 0; run < run_count; run++)
+			{
+				if (!readers[run].open(run_paths[run], run_lengths[run], block_elements))
+				{
+					fprintf(stderr, "Error opening run %s\n", run_paths[run].c_str());
+					return false;
+				}
+			}
+			if (!writer.open(output_path, block_elements))
+			{
+				fprintf(stderr, "Error creating %s\n", output_path.c_str());
+				return false;
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(progress_mutex);
+				progress.merge_run_lengths = run_lengths;
+				progress.merge_run_positions.assign(run_count, 0);
+				progress.elements_written = 0;
+			}
+
+			LoserTree<Key, KeyLess> tree(run_count);
+			for (int run = 0; run < run_count; run++) if (readers[run].hasKey()) tree.setSourceKey(run, readers[run].getKey());
+			tree.build();
+
+			std::uint64_t elements_written = 0;
+			while (!tree.isEmpty())
+			{
+				int run = tree.getWinnerSource();
+				bool block_written = writer.push(tree.getWinnerKey());
+				elements_written++;
+
+				if (readers[run].advance()) tree.replaceWinner(readers[run].getKey());
+				else tree.removeWinner();
+
+				if (block_written)
+				{
+					if (cancelled) return false;
+
+					std::lock_guard<std::mutex> lock(progress_mutex);
+					progress.elements_written = elements_written;
+					for (int i = 0; i < run_count; i++) progress.merge_run_positions[i] = readers[i].getConsumedElements();
+				}
+			}
+
+			bool merged = writer.close();
+			for (RunReader<Key>& reader : readers) if (reader.hasFailed()) merged = false;
+			if (!merged) fprintf(stderr, "Error merging into %s\n", output_path.c_str());
+
+			std::lock_guard<std::mutex> lock(progress_mutex);
+			progress.elements_written = elements_written;
+			for (int i = 0; i < run_count; i++) progress.merge_run_positions[i] = readers[i].getConsumedElements();
+			return merged;
+		}
+
+		void ExternalSorter::setPhase(ExternalSortPhase phase)
+		{
+			std::lock_guard<std::mutex> lock(progress_mutex);
+			progress.phase = phase;
+		}
+
+		std::string ExternalSorter::getRunPath(const std::string& output_path, int pass, int run)
+		{
+			return output_path + ".pass" + std::to_string(pass) + ".run" + std::to_string(run);
+		}
+
+		void ExternalSorter::cancel()
+		{
+			cancelled = true;
+		}
+
+		ExternalSortProgress ExternalSorter::getProgress()
+		{
+			std::lock_guard<std::mutex> lock(progress_mutex);
+			return progress;
+		}
+	}
+}
@@ -0,0 +1,280 @@
+#include "Gameplay/Collection/InputGenerator.h"
+#include "Global/ServiceLocator.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace Gameplay
+{
+	namespace Collection
+	{
+		namespace
+		{
+			const InputDistribution distributions[] = {
+				InputDistribution::SHUFFLED, InputDistribution::UNIFORM, InputDistribution::ZIPFIAN,
+				InputDistribution::FEW_UNIQUE, InputDistribution::NEARLY_SORTED, InputDistribution::REVERSED,
+				InputDistribution::SAWTOOTH, InputDistribution::ORGAN_PIPE, InputDistribution::GAUSSIAN,
+				InputDistribution::ADVERSARIAL,
+			};
+
+			// Maps the top 32 bits of a hash onto [0, range) without a division.
+			std::uint64_t scaleToRange(std::uint64_t hash, std::uint64_t range) { return ((hash >> 32) * range) >> 32; }
+
+			// Compares names ignoring case, spaces, '-' and '_', so "nearly-sorted" matches "Nearly Sorted".
+			bool matchesName(const char* name, const char* display_name)
+			{
+				while (true)
+				{
+					while (*name == ' ' || *name == '-' || *name == '_') name++;
+					while (*display_name == ' ') display_name++;
+
+					if (!*name || !*display_name) return !*name && !*display_name;
+					if (std::tolower(static_cast<unsigned char>(*name)) != std::tolower(static_cast<unsigned char>(*display_name))) return false;
+
+					name++;
+					display_name++;
+				}
+			}
+		}
+
+		std::uint64_t InputGenerator::hashIndex(std::uint64_t seed, std::uint64_t index)
+		{
+			// SplitMix64 finalizer over a Weyl sequence, good enough statistics and no state between indices.
+			std::uint64_t value = seed + (index + 1) * 0x9E3779B97F4A7C15ull;
+			value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+			value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+			return value ^ (value >> 31);
+		}
+
+		std::uint64_t InputGenerator::permuteIndex(const std::uint64_t* round_keys, int index_bits, std::uint64_t index, std::uint64_t count)
+		{
+			// A Feistel network is a bijection on [0, 2^index_bits); walking the cycle until the value falls below
+			// count restricts it to a bijection on [0, count). The domain is under 2 * count, so the walk is short.
+			// The halves may differ by a bit, so their widths swap every round and are back in place after four.
+			std::uint64_t value = index;
+			do
+			{
+				int left_bits = index_bits - index_bits / 2;
+				int right_bits = index_bits / 2;
+				std::uint64_t left = value >> right_bits;
+				std::uint64_t right = value & ((std::uint64_t(1) << right_bits) - 1);
+				for (int round = 0; round < 4; round++)
+				{
+					std::uint64_t next_right = left ^ ((((right ^ round_keys[round]) * 0x9E3779B97F4A7C15ull) >> 32) & ((std::uint64_t(1) << left_bits) - 1));
+					left = right;
+					right = next_right;
+					std::swap(left_bits, right_bits);
+				}
+				value = (left << right_bits) | right;
+			} while (value >= count);
+
+			return value;
+		}
+
+		void InputGenerator::generateRange(const InputSettings& settings, int* keys, std::size_t count, std::size_t begin, std::size_t end)
+		{
+			const std::uint64_t seed = settings.seed;
+			const std::uint64_t n = count;
+
+			switch (settings.distribution)
+			{
+			case InputDistribution::SHUFFLED:
+			{
+				int index_bits = 2;
+				while ((std::uint64_t(1) << index_bits) < n) index_bits++;
+
+				std::uint64_t round_keys[4];
+				for (int round = 0; round < 4; round++) round_keys[round] = hashIndex(seed, round);
+
+				for (std::size_t i = begin; i < end; i++) keys[i] = static_cast<int>(permuteIndex(round_keys, index_bits, i, n));
+				break;
+			}
+
+			case InputDistribution::UNIFORM:
+				for (std::size_t i = begin; i < end; i++) keys[i] = static_cast<int>(scaleToRange(hashIndex(seed, i), n));
+				break;
+
+			case InputDistribution::ZIPFIAN:
+			{
+				// Inverse CDF of the continuous Zipf (s = 1) distribution: rank = n^u for uniform u in [0, 1).
+				const double log_count = std::log(static_cast<double>(n));
+				for (std::size_t i = begin; i < end; i++)
+				{
+					double uniform = static_cast<double>(hashIndex(seed, i) >> 11) * (1.0 / 9007199254740992.0);
+					std::uint64_t rank = static_cast<std::uint64_t>(std::exp(uniform * log_count));
+					keys[i] = static_cast<int>(std::min(std::max<std::uint64_t>(rank, 1), n) - 1);
+				}
+				break;
+			}
+
+			case InputDistribution::FEW_UNIQUE:
+			{
+				const std::uint64_t unique_keys = std::min<std::uint64_t>(std::max(settings.unique_keys, 1), n);
+				const std::uint64_t key_spacing = n / unique_keys;
+				for (std::size_t i = begin; i < end; i++) keys[i] = static_cast<int>(scaleToRange(hashIndex(seed, i), unique_keys) * key_spacing);
+				break;
+			}
+
+			case InputDistribution::NEARLY_SORTED:
+			{
+				const std::uint64_t noise_threshold = (static_cast<std::uint64_t>(std::min(std::max(settings.noise_percent, 0), 100)) << 32) / 100;
+				for (std::size_t i = begin; i < end; i++)
+				{
+					std::uint64_t hash = hashIndex(seed, i);
+					keys[i] = (hash & 0xFFFFFFFFull) < noise_threshold ? static_cast<int>(scaleToRange(hash, n)) : static_cast<int>(i);
+				}
+				break;
+			}
+
+			case InputDistribution::REVERSED:
+				for (std::size_t i = begin; i < end; i++) keys[i] = static_cast<int>(n - 1 - i);
+				break;
+
+			case InputDistribution::SAWTOOTH:
+			{
+				const std::uint64_t teeth = std::min<std::uint64_t>(std::max(settings.sawtooth_teeth, 1), n);
+				const std::uint64_t period = (n + teeth - 1) / teeth;
+				const std::uint64_t key_scale = (n << 32) / period; // 32.32 fixed point n / period
+
+				// Tracks the phase instead of taking i % period for every key.
+				std::uint64_t phase = begin % period;
+				for (std::size_t i = begin; i < end; i++)
+				{
+					keys[i] = static_cast<int>((phase * key_scale) >> 32);
+					if (++phase == period) phase = 0;
+				}
+				break;
+			}
+
+			case InputDistribution::ORGAN_PIPE:
+			{
+				// Even keys on the way up, odd keys on the way down, so every key is still distinct.
+				const std::uint64_t half = (n + 1) / 2;
+				for (std::size_t i = begin; i < end; i++) keys[i] = static_cast<int>(i < half ? 2 * i : 2 * (n - 1 - i) + 1);
+				break;
+			}
+
+			case InputDistribution::GAUSSIAN:
+				// Irwin-Hall: the sum of four 16 bit uniforms, centred on n / 2 with a deviation of about n / 7.
+				for (std::size_t i = begin; i < end; i++)
+				{
+					std::uint64_t hash = hashIndex(seed, i);
+					std::uint64_t sum = (hash & 0xFFFF) + ((hash >> 16) & 0xFFFF) + ((hash >> 32) & 0xFFFF) + (hash >> 48);
+					keys[i] = static_cast<int>((sum * n) >> 18);
+				}
+				break;
+
+			case InputDistribution::ADVERSARIAL:
+				// Not a function of the index, generate() fills it in one pass with generateAdversarial().
+				break;
+			}
+		}
+
+		void InputGenerator::generate(const InputSettings& settings, int* keys, std::size_t count)
+		{
+			if (count == 0) return;
+
+			if (settings.distribution == InputDistribution::ADVERSARIAL)
+			{
+				generateAdversarial(settings.seed, keys, count);
+				return;
+			}
+
+			Global::ServiceLocator::getInstance()->getTaskService()->parallelFor(count, parallel_threshold, [&settings, keys, count](std::size_t begin, std::size_t end) {
+				generateRange(settings, keys, count, begin, end);
+			});
+		}
+
+		// Plays the adversary against partition() in StickCollectionController: it pivots on the last element of the
+		// range, so the keys are decided only when a stick becomes the pivot. Each pivot gets the smallest or the largest
+		// key still free (picked by the seed), so every partition splits off just the pivot and the sort makes
+		// n (n - 1) / 2 comparisons. Tracking where partition() moves the sticks keeps this linear.
+		void InputGenerator::generateAdversarial(std::uint64_t seed, int* keys, std::size_t count)
+		{
+			std::vector<std::size_t> positions(count);
+			for (std::size_t i = 0; i < count; i++) positions[i] = i;
+
+			std::size_t low = 0;
+			std::size_t high = count - 1;
+			int smallest_key = 0;
+			int largest_key = static_cast<int>(count) - 1;
+
+			while (low < high)
+			{
+				if (hashIndex(seed, high - low) & 1)
+				{
+					// Everything else is larger: the pivot is swapped with the stick at low and the range starts after it.
+					keys[positions[high]] = smallest_key++;
+					std::swap(positions[low], positions[high]);
+					low++;
+				}
+				else
+				{
+					// Everything else is smaller: every stick is swapped with itself and the pivot stays last.
+					keys[positions[high]] = largest_key--;
+					high--;
+				}
+			}
+			keys[positions[low]] = smallest_key;
+		}
+
+		std::uint64_t InputGenerator::createRandomSeed()
+		{
+			std::random_device device;
+			return (static_cast<std::uint64_t>(device()) << 32) | device();
+		}
+
+		const char* InputGenerator::getDistributionName(InputDistribution distribution)
+		{
+			switch (distribution)
+			{
+			case InputDistribution::SHUFFLED:
+				return "Shuffled";
+			case InputDistribution::UNIFORM:
+				return "Uniform";
+			case InputDistribution::ZIPFIAN:
+				return "Zipfian";
+			case InputDistribution::FEW_UNIQUE:
+				return "Few Unique";
+			case InputDistribution::NEARLY_SORTED:
+				return "Nearly Sorted";
+			case InputDistribution::REVERSED:
+				return "Reversed";
+			case InputDistribution::SAWTOOTH:
+				return "Sawtooth";
+			case InputDistribution::ORGAN_PIPE:
+				return "Organ Pipe";
+			case InputDistribution::GAUSSIAN:
+				return "Gaussian";
+			case InputDistribution::ADVERSARIAL:
+				return "Adversarial";
+			}
+			return "Unknown";
+		}
+
+		bool InputGenerator::parseDistribution(const char* name, InputDistribution& distribution)
+		{
+			for (InputDistribution candidate : distributions)
+			{
+				if (matchesName(name, getDistributionName(candidate)))
+				{
+					distribution = candidate;
+					return true;
+				}
+			}
+			return false;
+		}
+
+		InputDistribution InputGenerator::getNextDistribution(InputDistribution distribution)
+		{
+			const std::size_t distribution_count = sizeof(distributions) / sizeof(distributions[0]);
+			for (std::size_t i = 0; i < distribution_count; i++)
+			{
+				if (distributions[i] == distribution) return distributions[(i + 1) % distribution_count];
+			}
+			return InputDistribution::SHUFFLED;
+		}
+	}
+}
@@ -0,0 +1,81 @@
+#include "Gameplay/Collection/MergeBenchmark.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include "Gameplay/Collection/InputGenerator.h"
+#include "Gameplay/Collection/KWayMerge.h"
+
+namespace Gameplay
+{
+	namespace Collection
+	{
+		std::vector<MergeBenchmarkResult> MergeBenchmark::run(std::size_t key_count, int max_source_count, std::uint64_t seed)
+		{
+			std::vector<MergeBenchmarkResult> results;
+			if (key_count == 0) return results;
+
+			InputSettings settings;
+			settings.distribution = InputDistribution::UNIFORM;
+			settings.seed = seed;
+
+			std::vector<int> keys(key_count);
+			InputGenerator::generate(settings, keys.data(), keys.size());
+
+			MultisetHash keys_hash = SortVerifier::hashKeys(keys.data(), keys.size());
+			std::vector<int> output(key_count);
+			for (int source_count = 2; source_count <= max_source_count; source_count *= 2)
+			{
+				results.push_back(measure(keys, keys_hash, source_count, output));
+			}
+
+			return results;
+		}
+
+		MergeBenchmarkResult MergeBenchmark::measure(const std::vector<int>& keys, const MultisetHash& keys_hash, int source_count, std::vector<int>& output)
+		{
+			// Runs differ in length by at most one key, like the chunks of a multiway merge sort.
+			std::vector<int> runs = keys;
+			std::vector<KWayMerge::Range<std::vector<int>::const_iterator>> ranges;
+			for (int i = 0; i < source_count; i++)
+			{
+				std::size_t begin = runs.size() * i / source_count;
+				std::size_t end = runs.size() * (i + 1) / source_count;
+
+				std::sort(runs.begin() + begin, runs.begin() + end);
+				ranges.push_back(std::make_pair(runs.cbegin() + begin, runs.cbegin() + end));
+			}
+
+			MergeBenchmarkResult result;
+			result.source_count = source_count;
+
+			result.verified = true;
+
+			for (int i = 0; i < repetitions; i++)
+			{
+				std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+				KWayMerge::merge(ranges, output.begin());
+				double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+
+				if (i == 0 || milliseconds < result.milliseconds) result.milliseconds = milliseconds;
+				result.verified = result.verified && SortVerifier::verify(output.data(), output.size(), keys_hash).isValid(false);
+			}
+
+			result.nanoseconds_per_key = result.milliseconds * 1e6 / keys.size();
+			return result;
+		}
+
+		void MergeBenchmark::print(const std::vector<MergeBenchmarkResult>& results, std::size_t key_count)
+		{
+			printf("K-way merge of %zu keys\n", key_count);
+			printf("%6s %12s %10s %16s\n", "k", "ms", "ns/key", "ns/key/level");
+
+			for (const MergeBenchmarkResult& result : results)
+			{
+				double levels = std::log2(static_cast<double>(result.source_count));
+				printf("%6d %12.3f %10.2f %16.2f%s\n", result.source_count, result.milliseconds, result.nanoseconds_per_key,
+					result.nanoseconds_per_key / levels, result.verified ? "" : "  FAILED VERIFICATION");
+			}
+		}
+	}
+}
@@ -0,0 +1,499 @@
+#include "Gameplay/Collection/OperationLog.h"
+#include <algorithm>
+
+namespace Gameplay
+{
+	namespace Collection
+	{
+		namespace
+		{
+			// Element values may be negative, zigzag keeps small magnitudes short either way.
+			std::uint64_t encodeZigzag(std::int64_t value) { return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63); }
+
+			std::int64_t decodeZigzag(std::uint64_t value) { return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1); }
+		}
+
+		void OperationLogFormat::writeVarint(std::vector<std::uint8_t>& buffer, std::uint64_t value)
+		{
+			while (value >= 0x80)
+			{
+				buffer.push_back(static_cast<std::uint8_t>(value | 0x80));
+				value >>= 7;
+			}
+			buffer.push_back(static_cast<std::uint8_t>(value));
+		}
+
+		bool OperationLogFormat::readVarint(const std::uint8_t* data, std::size_t size, std::size_t& offset, std::uint64_t& value)
+		{
+			value = 0;
+			for (int shift = 0; shift < 64; shift += 7)
+			{
+				if (offset >= size) return false;
+
+				std::uint8_t byte = data[offset++];
+				value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+				if (!(byte & 0x80)) return true;
+			}
+			return false;
+		}
+
+		void OperationLogFormat::writeFixed(std::vector<std::uint8_t>& buffer, std::uint64_t value, int byte_count)
+		{
+			for (int i = 0; i < byte_count; i++) buffer.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+		}
+
+		std::uint64_t OperationLogFormat::readFixed(const std::uint8_t* data, int byte_count)
+		{
+			std::uint64_t value = 0;
+			for (int i = 0; i < byte_count; i++) value |= static_cast<std::uint64_t>(data[i]) << (8 * i);
+			return value;
+		}
+
+		OperationLogWriter::OperationLogWriter()
+		{
+			log_file = nullptr;
+			in_memory = false;
+			bytes_written = 0;
+			keyframe_interval = 0;
+			operation_count = 0;
+			operations_since_keyframe = 0;
+		}
+
+		OperationLogWriter::~OperationLogWriter()
+		{
+			close();
+		}
+
+		bool OperationLogWriter::open(const std::string& path, SortType sort_type, const std::vector<int>& element_data, int interval)
+		{
+			close();
+
+			log_file = std::fopen(path.c_str(), "wb");
+			if (!log_file)
+			{
+				fprintf(stderr, "Error opening operation log %s\n", path.c_str());
+				return false;
+			}
+
+			writeHeader(sort_type, element_data, interval);
+			return true;
+		}
+
+		void OperationLogWriter::openInMemory(SortType sort_type, const std::vector<int>& element_data, int interval)
+		{
+			close();
+
+			in_memory = true;
+			writeHeader(sort_type, element_data, interval);
+		}
+
+		void OperationLogWriter::writeHeader(SortType sort_type, const std::vector<int>& element_data, int interval)
+		{
+			bytes_written = 0;
+			keyframe_interval = std::max(1, interval);
+			operation_count = 0;
+			operations_since_keyframe = 0;
+			keyframe_table.clear();
+			buffer.clear();
+
+			OperationLogFormat::writeFixed(buffer, OperationLogFormat::magic, 4);
+			OperationLogFormat::writeFixed(buffer, OperationLogFormat::version, 4);
+			OperationLogFormat::writeFixed(buffer, static_cast<std::uint8_t>(sort_type), 1);
+			OperationLogFormat::writeFixed(buffer, keyframe_interval, 4);
+			OperationLogFormat::writeVarint(buffer, element_data.size());
+			for (int value : element_data) OperationLogFormat::writeVarint(buffer, encodeZigzag(value));
+		}
+
+		void OperationLogWriter::writeRecordLength(std::size_t record_start)
+		{
+			buffer.push_back(static_cast<std::uint8_t>(buffer.size() - record_start + 1));
+		}
+
+		void OperationLogWriter::writeOperation(const Operation& operation)
+		{
+			std::size_t record_start = buffer.size();
+			buffer.push_back(static_cast<std::uint8_t>(operation.type));
+
+			switch (operation.type)
+			{
+			case OperationType::STEP:
+				OperationLogFormat::writeVarint(buffer, operation.first);
+				OperationLogFormat::writeVarint(buffer, operation.second);
+				OperationLogFormat::writeVarint(buffer, operation.third);
+				break;
+			case OperationType::SWAP:
+				OperationLogFormat::writeVarint(buffer, operation.first);
+				OperationLogFormat::writeVarint(buffer, operation.second);
+				break;
+			case OperationType::WRITE:
+			case OperationType::MERGE_NODE:
+				OperationLogFormat::writeVarint(buffer, operation.first);
+				OperationLogFormat::writeVarint(buffer, operation.second);
+				OperationLogFormat::writeVarint(buffer, operation.third);
+				break;
+			case OperationType::SET_COLOR:
+				OperationLogFormat::writeVarint(buffer, operation.first);
+				buffer.push_back(static_cast<std::uint8_t>(operation.second));
+				buffer.push_back(static_cast<std::uint8_t>(operation.third));
+				break;
+			case OperationType::PLAY_SOUND:
+				OperationLogFormat::writeVarint(buffer, operation.first);
+				break;
+			default:
+				break;
+			}
+
+			writeRecordLength(record_start);
+			operation_count++;
+			operations_since_keyframe++;
+
+			if (buffer.size() >= flush_threshold) flush();
+		}
+
+		void OperationLogWriter::writeKeyframe(const OperationLogKeyframe& keyframe)
+		{
+			std::size_t record_start = buffer.size();
+			keyframe_table.push_back(std::make_pair(operation_count, bytes_written + buffer.size()));
+			operations_since_keyframe = 0;
+
+			buffer.push_back(static_cast<std::uint8_t>(OperationType::KEYFRAME));
+			OperationLogFormat::writeVarint(buffer, operation_count);
+			OperationLogFormat::writeVarint(buffer, keyframe.number_of_comparisons);
+			OperationLogFormat::writeVarint(buffer, keyframe.number_of_array_access);
+			OperationLogFormat::writeVarint(buffer, keyframe.stick_ids.size());
+			for (int stick_id : keyframe.stick_ids) OperationLogFormat::writeVarint(buffer, stick_id);
+			for (ElementColor color : keyframe.colors) buffer.push_back(static_cast<std::uint8_t>(color));
+
+			// Operation records are never shorter than two bytes, so a zero length marks a keyframe.
+			OperationLogFormat::writeFixed(buffer, buffer.size() - record_start + OperationLogFormat::keyframe_trailer_size, 4);
+			buffer.push_back(0);
+
+			if (buffer.size() >= flush_threshold) flush();
+		}
+
+		bool OperationLogWriter::needsKeyframe()
+		{
+			return operations_since_keyframe >= keyframe_interval;
+		}
+
+		void OperationLogWriter::flush()
+		{
+			if (!log_file || buffer.empty()) return;
+
+			std::fwrite(buffer.data(), 1, buffer.size(), log_file);
+			bytes_written += buffer.size();
+			buffer.clear();
+		}
+
+		// Appends the keyframe table and footer; a log without a footer is treated as unreadable.
+		void OperationLogWriter::close()
+		{
+			if (!log_file && !in_memory) return;
+
+			std::uint64_t stream_end = bytes_written + buffer.size();
+			for (const auto& entry : keyframe_table)
+			{
+				OperationLogFormat::writeFixed(buffer, entry.first, 8);
+				OperationLogFormat::writeFixed(buffer, entry.second, 8);
+			}
+
+			OperationLogFormat::writeFixed(buffer, stream_end, 8);
+			OperationLogFormat::writeFixed(buffer, keyframe_table.size(), 8);
+			OperationLogFormat::writeFixed(buffer, operation_count, 8);
+			OperationLogFormat::writeFixed(buffer, stream_end, 8);
+			OperationLogFormat::writeFixed(buffer, OperationLogFormat::magic, 4);
+			OperationLogFormat::writeFixed(buffer, OperationLogFormat::version, 4);
+
+			in_memory = false;
+			if (!log_file) return;
+
+			flush();
+			std::fclose(log_file);
+			log_file = nullptr;
+		}
+
+		std::vector<std::uint8_t> OperationLogWriter::releaseBuffer()
+		{
+			std::vector<std::uint8_t> released;
+			released.swap(buffer);
+			return released;
+		}
+
+		std::int64_t OperationLogWriter::getOperationCount() { return operation_count; }
+
+		OperationLogReader::OperationLogReader()
+		{
+			log_data = nullptr;
+			log_size = 0;
+			sort_type = SortType::BUBBLE_SORT;
+			keyframe_interval = 0;
+			operation_count = 0;
+			stream_start = 0;
+			stream_end = 0;
+		}
+
+		bool OperationLogReader::open(const std::string& path)
+		{
+			close();
+
+			if (!mapped_file.open(path, Global::MappedFileAccess::NORMAL))
+			{
+				fprintf(stderr, "Error opening operation log %s\n", path.c_str());
+				return false;
+			}
+
+			log_data = mapped_file.getData();
+			log_size = mapped_file.getSize();
+
+			if (!readLog())
+			{
+				fprintf(stderr, "Invalid operation log %s\n", path.c_str());
+				return false;
+			}
+
+			return true;
+		}
+
+		bool OperationLogReader::open(std::vector<std::uint8_t>&& buffer)
+		{
+			close();
+
+			log_buffer = std::move(buffer);
+			log_data = log_buffer.data();
+			log_size = log_buffer.size();
+
+			if (!readLog())
+			{
+				fprintf(stderr, "Invalid in-memory operation log\n");
+				return false;
+			}
+
+			return true;
+		}
+
+		bool OperationLogReader::readLog()
+		{
+			if (readHeader() && readFooter()) return true;
+
+			close();
+			return false;
+		}
+
+		void OperationLogReader::close()
+		{
+			mapped_file.close();
+			log_buffer.clear();
+			log_data = nullptr;
+			log_size = 0;
+			element_data.clear();
+			keyframe_table.clear();
+			operation_count = 0;
+		}
+
+		bool OperationLogReader::isOpen() { return log_data != nullptr; }
+
+		bool OperationLogReader::readHeader()
+		{
+			const std::uint8_t* data = log_data;
+			std::size_t size = log_size;
+			if (size < 13 + OperationLogFormat::footer_size) return false;
+
+			if (OperationLogFormat::readFixed(data, 4) != OperationLogFormat::magic) return false;
+			if (OperationLogFormat::readFixed(data + 4, 4) != OperationLogFormat::version) return false;
+
+			sort_type = static_cast<SortType>(data[8]);
+			keyframe_interval = static_cast<int>(OperationLogFormat::readFixed(data + 9, 4));
+
+			std::size_t offset = 13;
+			std::uint64_t element_count;
+			if (!OperationLogFormat::readVarint(data, size, offset, element_count)) return false;
+
+			// Every element takes at least a byte, so a corrupt count fails here instead of in the allocation.
+			if (offset > size - OperationLogFormat::footer_size || element_count > size - OperationLogFormat::footer_size - offset) return false;
+			element_data.resize(static_cast<std::size_t>(element_count));
+			for (int& value : element_data)
+			{
+				std::uint64_t encoded;
+				if (!OperationLogFormat::readVarint(data, size, offset, encoded)) return false;
+				value = static_cast<int>(decodeZigzag(encoded));
+			}
+
+			stream_start = offset;
+			return true;
+		}
+
+		bool OperationLogReader::readFooter()
+		{
+			const std::uint8_t* data = log_data;
+			std::size_t size = log_size;
+			const std::uint8_t* footer = data + size - OperationLogFormat::footer_size;
+
+			if (OperationLogFormat::readFixed(footer + 32, 4) != OperationLogFormat::magic) return false;
+
+			std::uint64_t table_offset = OperationLogFormat::readFixed(footer, 8);
+			std::uint64_t keyframe_count = OperationLogFormat::readFixed(footer + 8, 8);
+			operation_count = static_cast<std::int64_t>(OperationLogFormat::readFixed(footer + 16, 8));
+			stream_end = static_cast<std::size_t>(OperationLogFormat::readFixed(footer + 24, 8));
+
+			std::size_t table_end = size - OperationLogFormat::footer_size;
+			if (keyframe_count == 0 || stream_end < stream_start || stream_end > table_offset || table_offset > table_end ||
+				keyframe_count > (table_end - table_offset) / 16) return false;
+
+			keyframe_table.resize(static_cast<std::size_t>(keyframe_count));
+			for (std::size_t i = 0; i < keyframe_table.size(); i++)
+			{
+				const std::uint8_t* entry = data + table_offset + i * 16;
+				keyframe_table[i].first = static_cast<std::int64_t>(OperationLogFormat::readFixed(entry, 8));
+				keyframe_table[i].second = OperationLogFormat::readFixed(entry + 8, 8);
+			}
+
+			return true;
+		}
+
+		bool OperationLogReader::readKeyframeAt(std::size_t& offset, OperationLogKeyframe& keyframe)
+		{
+			const std::uint8_t* data = log_data;
+			std::uint64_t value;
+
+			if (offset >= stream_end || data[offset++] != static_cast<std::uint8_t>(OperationType::KEYFRAME)) return false;
+
+			if (!OperationLogFormat::readVarint(data, stream_end, offset, value)) return false;
+			keyframe.operation_index = static_cast<std::int64_t>(value);
+			if (!OperationLogFormat::readVarint(data, stream_end, offset, value)) return false;
+			keyframe.number_of_comparisons = static_cast<std::int64_t>(value);
+			if (!OperationLogFormat::readVarint(data, stream_end, offset, value)) return false;
+			keyframe.number_of_array_access = static_cast<std::int64_t>(value);
+			if (!OperationLogFormat::readVarint(data, stream_end, offset, value)) return false;
+
+			// A stick id and its color take at least two bytes.
+			if (value > (stream_end - offset) / 2) return false;
+			keyframe.stick_ids.resize(static_cast<std::size_t>(value));
+			keyframe.colors.resize(static_cast<std::size_t>(value));
+
+			for (int& stick_id : keyframe.stick_ids)
+			{
+				if (!OperationLogFormat::readVarint(data, stream_end, offset, value)) return false;
+				stick_id = static_cast<int>(value);
+			}
+
+			if (offset + keyframe.colors.size() + OperationLogFormat::keyframe_trailer_size > stream_end) return false;
+			for (ElementColor& color : keyframe.colors) color = static_cast<ElementColor>(data[offset++]);
+
+			offset += OperationLogFormat::keyframe_trailer_size;
+			return true;
+		}
+
+		bool OperationLogReader::readOperation(std::size_t& offset, Operation& operation)
+		{
+			// Keyframes are only needed for seeking.
+			while (offset < stream_end && log_data[offset] == static_cast<std::uint8_t>(OperationType::KEYFRAME))
+			{
+				OperationLogKeyframe skipped_keyframe;
+				if (!readKeyframeAt(offset, skipped_keyframe)) return false;
+			}
+
+			return decodeOperation(offset, operation);
+		}
+
+		bool OperationLogReader::readPreviousOperation(std::size_t& offset, Operation& operation)
+		{
+			while (offset > stream_start && offset <= stream_end && log_data[offset - 1] == 0)
+			{
+				if (offset < stream_start + OperationLogFormat::keyframe_trailer_size) return false;
+
+				std::size_t keyframe_size = static_cast<std::size_t>(OperationLogFormat::readFixed(log_data + offset - OperationLogFormat::keyframe_trailer_size, 4));
+				if (keyframe_size > offset - stream_start) return false;
+				offset -= keyframe_size;
+			}
+
+			if (offset <= stream_start || offset > stream_end) return false;
+
+			std::size_t record_size = log_data[offset - 1];
+			if (record_size > offset - stream_start) return false;
+
+			std::size_t record_start = offset - record_size;
+			std::size_t decode_offset = record_start;
+			if (!decodeOperation(decode_offset, operation) || decode_offset != offset) return false;
+
+			offset = record_start;
+			return true;
+		}
+
+		bool OperationLogReader::decodeOperation(std::size_t& offset, Operation& operation)
+		{
+			const std::uint8_t* data = log_data;
+			std::uint64_t value;
+
+			if (offset >= stream_end) return false;
+
+			operation = Operation();
+			operation.type = static_cast<OperationType>(data[offset++]);
+
+			switch (operation.type)
+			{
+			case OperationType::STEP:
+				if (!OperationLogFormat::readVarint(data, stream_end, offset, value)) return false;
+				operation.first = static_cast<int>(value);
+				if (!OperationLogFormat::readVarint(data, stream_end, offset, value)) return false;
+				operation.second = static_cast<int>(value);
+				if (!OperationLogFormat::readVarint(data, stream_end, offset, value)) return false;
+				operation.third = static_cast<int>(value);
+				break;
+			case OperationType::SWAP:
+				if (!OperationLogFormat::readVarint(data, stream_end, offset, value)) return false;
+				operation.first = static_cast<int>(value);
+				if (!OperationLogFormat::readVarint(data, stream_end, offset, value)) return false;
+				operation.second = static_cast<int>(value);
+				break;
+			case OperationType::WRITE:
+			case OperationType::MERGE_NODE:
+				if (!OperationLogFormat::readVarint(data, stream_end, offset, value)) return false;
+				operation.first = static_cast<int>(value);
+				if (!OperationLogFormat::readVarint(data, stream_end, offset, value)) return false;
+				operation.second = static_cast<int>(value);
+				if (!OperationLogFormat::readVarint(data, stream_end, offset, value)) return false;
+				operation.third = static_cast<int>(value);
+				break;
+			case OperationType::SET_COLOR:
+				if (!OperationLogFormat::readVarint(data, stream_end, offset, value) || offset + 2 > stream_end) return false;
+				operation.first = static_cast<int>(value);
+				operation.second = data[offset++];
+				operation.third = data[offset++];
+				break;
+			case OperationType::PLAY_SOUND:
+				if (!OperationLogFormat::readVarint(data, stream_end, offset, value)) return false;
+				operation.first = static_cast<int>(value);
+				break;
+			default:
+				return false;
+			}
+
+			// Skip the trailing record length.
+			if (offset >= stream_end) return false;
+			offset++;
+			return true;
+		}
+
+		bool OperationLogReader::seekKeyframe(std::int64_t operation_index, OperationLogKeyframe& keyframe, std::size_t& offset)
+		{
+			auto entry = std::upper_bound(keyframe_table.begin(), keyframe_table.end(), operation_index,
+				[](std::int64_t index, const std::pair<std::int64_t, std::uint64_t>& table_entry) { return index < table_entry.first; });
+
+			if (entry == keyframe_table.begin()) return false;
+			--entry;
+
+			offset = static_cast<std::size_t>(entry->second);
+			return readKeyframeAt(offset, keyframe);
+		}
+
+		SortType OperationLogReader::getSortType() { return sort_type; }
+
+		int OperationLogReader::getKeyframeInterval() { return keyframe_interval; }
+
+		int OperationLogReader::getElementCount() { return static_cast<int>(element_data.size()); }
+
+		const std::vector<int>& OperationLogReader::getElementData() { return element_data; }
+
+		std::int64_t OperationLogReader::getOperationCount() { return operation_count; }
+	}
+}
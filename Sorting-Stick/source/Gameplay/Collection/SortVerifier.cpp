@@ -0,0 +1,224 @@
+#include "Gameplay/Collection/SortVerifier.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include "Global/ServiceLocator.h"
+
+namespace Gameplay
+{
+	namespace Collection
+	{
+		namespace
+		{
+			std::uint64_t mixKey(std::uint64_t value, std::uint64_t seed)
+			{
+				value = (value + seed) * 0x9E3779B97F4A7C15ull;
+				value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+				value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+				return value ^ (value >> 31);
+			}
+
+			std::uint64_t getKeyBits(int key) { return static_cast<std::uint32_t>(key); }
+
+			std::uint64_t getPairBits(int key, int index) { return (getKeyBits(key) << 32) | static_cast<std::uint32_t>(index); }
+
+			std::uint64_t getKeyBits(float key)
+			{
+				std::uint32_t bits;
+				std::memcpy(&bits, &key, sizeof(bits));
+				return bits;
+			}
+
+			std::uint64_t getKeyBits(double key)
+			{
+				std::uint64_t bits;
+				std::memcpy(&bits, &key, sizeof(bits));
+				return bits;
+			}
+
+			void addKey(MultisetHash& hash, std::uint64_t bits)
+			{
+				hash.first_sum += mixKey(bits, 0x243F6A8885A308D3ull);
+				hash.second_sum += mixKey(bits, 0x13198A2E03707344ull);
+				hash.count++;
+			}
+
+			template <typename Key>
+			void addKeys(MultisetHash& hash, const Key* keys, std::size_t begin, std::size_t end)
+			{
+				for (std::size_t i = begin; i < end; i++) addKey(hash, getKeyBits(keys[i]));
+			}
+
+			void mergeHash(MultisetHash& hash, const MultisetHash& other)
+			{
+				hash.first_sum += other.first_sum;
+				hash.second_sum += other.second_sum;
+				hash.count += other.count;
+			}
+
+			// Keeps the lowest failing index, which is the one a sequential check would have reported.
+			void mergeVerification(SortVerification& verification, const SortVerification& other)
+			{
+				if (!other.sorted && (verification.sorted || other.first_unsorted_index < verification.first_unsorted_index))
+				{
+					verification.sorted = false;
+					verification.first_unsorted_index = other.first_unsorted_index;
+				}
+				if (!other.stable && (verification.stable || other.first_unstable_index < verification.first_unstable_index))
+				{
+					verification.stable = false;
+					verification.first_unstable_index = other.first_unstable_index;
+				}
+				verification.permutation = verification.permutation && other.permutation;
+			}
+
+			// Runs check(begin, end, result) over chunks of [0, count) on the task pool and folds the per chunk results with merge.
+			template <typename Result, typename Check, typename Merge>
+			Result runChunks(std::size_t count, std::size_t parallel_threshold, Check check, Merge merge)
+			{
+				Result result;
+				bool has_result = false;
+				std::mutex result_mutex;
+
+				Global::ServiceLocator::getInstance()->getTaskService()->parallelFor(count, parallel_threshold, [&](std::size_t begin, std::size_t end) {
+					Result chunk_result;
+					check(begin, end, chunk_result);
+
+					std::lock_guard<std::mutex> lock(result_mutex);
+					if (has_result) merge(result, chunk_result);
+					else result = chunk_result;
+					has_result = true;
+				});
+
+				return result;
+			}
+
+			template <typename Key>
+			MultisetHash hashRange(const Key* keys, std::size_t count, std::size_t parallel_threshold)
+			{
+				return runChunks<MultisetHash>(count, parallel_threshold,
+					[keys](std::size_t begin, std::size_t end, MultisetHash& hash) { addKeys(hash, keys, begin, end); },
+					mergeHash);
+			}
+
+			template <typename Key>
+			SortVerification verifyRange(const Key* output, std::size_t count, const MultisetHash& input_hash, std::size_t parallel_threshold)
+			{
+				struct ChunkResult
+				{
+					SortVerification verification;
+					MultisetHash hash;
+				};
+
+				ChunkResult result = runChunks<ChunkResult>(count, parallel_threshold,
+					[output](std::size_t begin, std::size_t end, ChunkResult& chunk) {
+						for (std::size_t i = std::max<std::size_t>(begin, 1); i < end; i++)
+						{
+							if (output[i] < output[i - 1])
+							{
+								chunk.verification.sorted = false;
+								chunk.verification.first_unsorted_index = i;
+								break;
+							}
+						}
+						addKeys(chunk.hash, output, begin, end);
+					},
+					[](ChunkResult& merged, const ChunkResult& chunk) {
+						mergeVerification(merged.verification, chunk.verification);
+						mergeHash(merged.hash, chunk.hash);
+					});
+
+				result.verification.permutation = result.hash == input_hash;
+				return result.verification;
+			}
+		}
+
+		bool MultisetHash::operator==(const MultisetHash& other) const
+		{
+			return first_sum == other.first_sum && second_sum == other.second_sum && count == other.count;
+		}
+
+		bool MultisetHash::operator!=(const MultisetHash& other) const { return !(*this == other); }
+
+		bool SortVerification::isValid(bool require_stability) const
+		{
+			return sorted && permutation && (!require_stability || !stability_checked || stable);
+		}
+
+		MultisetHash SortVerifier::hashKeys(const int* keys, std::size_t count) { return hashRange(keys, count, parallel_threshold); }
+
+		MultisetHash SortVerifier::hashKeys(const float* keys, std::size_t count) { return hashRange(keys, count, parallel_threshold); }
+
+		MultisetHash SortVerifier::hashKeys(const double* keys, std::size_t count) { return hashRange(keys, count, parallel_threshold); }
+
+		SortVerification SortVerifier::verify(const int* output, std::size_t count, const MultisetHash& input_hash)
+		{
+			return verifyRange(output, count, input_hash, parallel_threshold);
+		}
+
+		SortVerification SortVerifier::verify(const float* output, std::size_t count, const MultisetHash& input_hash)
+		{
+			return verifyRange(output, count, input_hash, parallel_threshold);
+		}
+
+		SortVerification SortVerifier::verify(const double* output, std::size_t count, const MultisetHash& input_hash)
+		{
+			return verifyRange(output, count, input_hash, parallel_threshold);
+		}
+
+		SortVerification SortVerifier::verifyTagged(const int* input, const int* output, const int* output_origins, std::size_t count)
+		{
+			struct ChunkResult
+			{
+				SortVerification verification;
+				MultisetHash input_hash;
+				MultisetHash output_hash;
+			};
+
+			// Hashing (key, index) pairs on both sides checks the keys and their origins in one sequential pass each,
+			// instead of looking up input[origin] at random.
+			ChunkResult result = runChunks<ChunkResult>(count, parallel_threshold,
+				[input, output, output_origins](std::size_t begin, std::size_t end, ChunkResult& chunk) {
+					SortVerification& verification = chunk.verification;
+
+					for (std::size_t i = begin; i < end; i++)
+					{
+						int origin = output_origins[i];
+						addKey(chunk.output_hash, getPairBits(output[i], origin));
+						addKey(chunk.input_hash, getPairBits(input[i], static_cast<int>(i)));
+
+						if (i == 0) continue;
+
+						if (output[i] < output[i - 1] && verification.sorted)
+						{
+							verification.sorted = false;
+							verification.first_unsorted_index = i;
+						}
+						else if (output[i] == output[i - 1] && origin < output_origins[i - 1] && verification.stable)
+						{
+							verification.stable = false;
+							verification.first_unstable_index = i;
+						}
+					}
+				},
+				[](ChunkResult& merged, const ChunkResult& chunk) {
+					mergeVerification(merged.verification, chunk.verification);
+					mergeHash(merged.input_hash, chunk.input_hash);
+					mergeHash(merged.output_hash, chunk.output_hash);
+				});
+
+			result.verification.stability_checked = true;
+			result.verification.permutation = result.input_hash == result.output_hash;
+			return result.verification;
+		}
+
+		void SortVerifier::printFailures(const SortVerification& verification, const char* name, bool require_stability)
+		{
+			if (!verification.sorted) fprintf(stderr, "%s: output is not sorted at index %zu\n", name, verification.first_unsorted_index);
+			if (!verification.permutation) fprintf(stderr, "%s: output is not a permutation of the input\n", name);
+			if (require_stability && verification.stability_checked && !verification.stable)
+				fprintf(stderr, "%s: equal keys changed order at index %zu\n", name, verification.first_unstable_index);
+		}
+	}
+}
@@ -0,0 +1,156 @@
+#include "Gameplay/Collection/StickBarRenderer.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace Gameplay
+{
+	namespace Collection
+	{
+		namespace
+		{
+			const int palette_size = 5; // one entry per ElementColor
+
+			// Texture coordinates run from 0 to 1 across the collection. A bar's height is stored in 16 bits (red high,
+			// green low), its ElementColor in blue. Bars narrower than a pixel are widened to one, so large collections
+			// still cover the area instead of falling between pixel centres.
+			const char* bar_fragment_shader = R"(
+				uniform sampler2D data;
+				uniform sampler2D palette;
+				uniform vec2 data_size;
+				uniform float element_count;
+				uniform float slot_width;
+				uniform float bar_width;
+				uniform float palette_size;
+
+				void main()
+				{
+					vec2 position = gl_TexCoord[0].xy;
+					float index = min(floor(position.x / slot_width), element_count - 1.0);
+					if (position.x - index * slot_width > max(bar_width, fwidth(position.x))) discard;
+
+					float row = floor((index + 0.5) / data_size.x);
+					vec2 texel = vec2(index - row * data_size.x + 0.5, row + 0.5) / data_size;
+					vec4 bar = texture2D(data, texel);
+
+					float height = (bar.r * 65280.0 + bar.g * 255.0) / 65535.0;
+					if (1.0 - position.y > height) discard;
+
+					gl_FragColor = texture2D(palette, vec2((bar.b * 255.0 + 0.5) / palette_size, 0.5)) * gl_Color;
+				}
+			)";
+		}
+
+		StickBarRenderer::StickBarRenderer()
+		{
+			bar_quad.setPrimitiveType(sf::TriangleStrip);
+			data_texture_width = 0;
+			data_texture_height = 0;
+			element_count = 0;
+			dirty_first = 0;
+			dirty_last = -1;
+		}
+
+		bool StickBarRenderer::isAvailable() { return sf::Shader::isAvailable(); }
+
+		bool StickBarRenderer::initialize(StickCollectionModel* collection_model)
+		{
+			element_count = collection_model->number_of_elements;
+			data_texture_width = std::min<unsigned int>({ static_cast<unsigned int>(element_count), max_data_texture_width, sf::Texture::getMaximumSize() });
+			data_texture_height = (element_count + data_texture_width - 1) / data_texture_width;
+
+			if (data_texture_height > sf::Texture::getMaximumSize() || !data_texture.create(data_texture_width, data_texture_height))
+			{
+				fprintf(stderr, "Error creating the %d element stick data texture\n", element_count);
+				return false;
+			}
+
+			if (!createPalette(collection_model)) return false;
+
+			if (!bar_shader.loadFromMemory(bar_fragment_shader, sf::Shader::Fragment))
+			{
+				fprintf(stderr, "Error compiling the stick bar shader\n");
+				return false;
+			}
+
+			texels.assign(static_cast<std::size_t>(data_texture_width) * data_texture_height * bytes_per_texel, 0);
+
+			float slot_width = collection_model->element_width + collection_model->elements_spacing;
+			bar_shader.setUniform("data", data_texture);
+			bar_shader.setUniform("palette", palette_texture);
+			bar_shader.setUniform("data_size", sf::Glsl::Vec2(static_cast<float>(data_texture_width), static_cast<float>(data_texture_height)));
+			bar_shader.setUniform("element_count", static_cast<float>(element_count));
+			bar_shader.setUniform("slot_width", slot_width / collection_model->collection_width);
+			bar_shader.setUniform("bar_width", collection_model->element_width / collection_model->collection_width);
+			bar_shader.setUniform("palette_size", static_cast<float>(palette_size));
+
+			float left = collection_model->collection_x_position;
+			float right = left + collection_model->collection_width;
+			float bottom = collection_model->element_y_position;
+			float top = bottom - collection_model->max_element_height;
+
+			bar_quad.resize(4);
+			bar_quad[0] = sf::Vertex(sf::Vector2f(left, top), sf::Color::White, sf::Vector2f(0.f, 0.f));
+			bar_quad[1] = sf::Vertex(sf::Vector2f(right, top), sf::Color::White, sf::Vector2f(1.f, 0.f));
+			bar_quad[2] = sf::Vertex(sf::Vector2f(left, bottom), sf::Color::White, sf::Vector2f(0.f, 1.f));
+			bar_quad[3] = sf::Vertex(sf::Vector2f(right, bottom), sf::Color::White, sf::Vector2f(1.f, 1.f));
+			return true;
+		}
+
+		bool StickBarRenderer::createPalette(StickCollectionModel* collection_model)
+		{
+			sf::Image palette_image;
+			palette_image.create(palette_size, 1);
+			for (int i = 0; i < palette_size; i++) palette_image.setPixel(i, 0, collection_model->getElementColor(static_cast<ElementColor>(i)));
+
+			if (!palette_texture.loadFromImage(palette_image))
+			{
+				fprintf(stderr, "Error creating the stick palette texture\n");
+				return false;
+			}
+
+			return true;
+		}
+
+		void StickBarRenderer::setBar(int index, float height_fraction, ElementColor color)
+		{
+			if (index < 0 || index >= element_count) return;
+
+			sf::Uint16 height = static_cast<sf::Uint16>(std::max(0.f, std::min(height_fraction, 1.f)) * 65535.f + 0.5f);
+			sf::Uint8* texel = &texels[static_cast<std::size_t>(index) * bytes_per_texel];
+			texel[0] = static_cast<sf::Uint8>(height >> 8);
+			texel[1] = static_cast<sf::Uint8>(height & 0xFF);
+			texel[2] = static_cast<sf::Uint8>(color);
+			texel[3] = 255;
+
+			if (dirty_first > dirty_last)
+			{
+				dirty_first = index;
+				dirty_last = index;
+			}
+			else
+			{
+				dirty_first = std::min(dirty_first, index);
+				dirty_last = std::max(dirty_last, index);
+			}
+		}
+
+		// Texture::update takes whole rectangles, so the span is widened to full rows.
+		void StickBarRenderer::uploadDirtyRows()
+		{
+			if (dirty_first > dirty_last) return;
+
+			unsigned int first_row = dirty_first / data_texture_width;
+			unsigned int row_count = dirty_last / data_texture_width - first_row + 1;
+			data_texture.update(&texels[static_cast<std::size_t>(first_row) * data_texture_width * bytes_per_texel], data_texture_width, row_count, 0, first_row);
+
+			dirty_first = 0;
+			dirty_last = -1;
+		}
+
+		void StickBarRenderer::render(sf::RenderTarget* render_target)
+		{
+			uploadDirtyRows();
+			render_target->draw(bar_quad, &bar_shader);
+		}
+	}
+}
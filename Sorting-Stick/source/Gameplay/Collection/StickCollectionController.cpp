@@ -1,16 +1,36 @@
 #include "Gameplay/Collection/StickCollectionController.h"
 #include "Gameplay/Collection/StickCollectionView.h"
+#include "Gameplay/Collection/StickBarRenderer.h"
 #include "Gameplay/Collection/StickCollectionModel.h"
 #include "Gameplay/GameplayService.h"
 #include "Global/ServiceLocator.h"
 #include "Gameplay/Collection/Stick.h"
-#include <random>
+#include "Gameplay/Collection/OperationLog.h"
+#include "Gameplay/Collection/LoserTree.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
 #include <iostream>
 
 namespace Gameplay
 {
 	namespace Collection
 	{
+		namespace
+		{
+			// Orders run heads in the multiway merge and counts every comparison the loser tree makes.
+			struct StickDataLess
+			{
+				int* comparisons;
+
+				bool operator()(const Stick* a, const Stick* b) const
+				{
+					(*comparisons)++;
+					return a->data < b->data;
+				}
+			};
+		}
+
 		using namespace UI::UIElement;
 		using namespace Global;
 		using namespace Graphics;
@@ -20,8 +40,39 @@ namespace Gameplay
 		{
 			collection_view = new StickCollectionView();
 			collection_model = new StickCollectionModel();
-
-			for (int i = 0; i < collection_model->number_of_elements; i++) sticks.push_back(new Stick(i));
+			bar_renderer = nullptr;
+			display_frame = 0;
+
+			sort_task_pending = false;
+			sort_thread_finished = true;
+			sort_cancelled = false;
+			reset_pending = false;
+			fixed_timestep = false;
+			sound_enabled = true;
+			published_operation_count = 0;
+			sort_duration_microseconds = 0;
+
+			operation_log_writer = nullptr;
+			operation_log_reader = nullptr;
+			recorded_comparisons = 0;
+			recorded_array_access = 0;
+			playback_offset = 0;
+			playback_operation_index = 0;
+			playback_time = 0;
+			playback_pending_delay = 0;
+			skip_playback_delays = false;
+			playback_paused = false;
+			playback_reversed = false;
+			playback_comparisons = 0;
+			playback_array_access = 0;
+			randomize_input_seed = true;
+
+			for (int i = 0; i < collection_model->number_of_elements; i++) stick_pool.push_back(new Stick(i, i));
+			sticks = stick_pool;
+			display_sticks = stick_pool;
+			sort_colors.assign(stick_pool.size(), ElementColor::DEFAULT);
+			merge_tree_states.assign(collection_model->multiway_merge_fan_in, 0);
+			sort_merge_tree_states = merge_tree_states;
 		}
 
 		StickCollectionController::~StickCollectionController()
@@ -32,10 +83,12 @@ namespace Gameplay
 		void StickCollectionController::initialize()
 		{
 			collection_view->initialize(this);
+			collection_view->createMergeTree(collection_model->multiway_merge_fan_in, sf::FloatRect(collection_model->collection_x_position,
+				collection_model->element_y_position - collection_model->max_element_height, collection_model->collection_width, collection_model->max_element_height));
 			initializeSticks();
 			reset();
+			completeReset();
 			sort_state = SortState::NOT_SORTING;
-			color_delay = collection_model->initial_color_delay;
 		}
 
 		void StickCollectionController::initializeSticks()
@@ -44,32 +97,40 @@ namespace Gameplay
 
 			for (int i = 0; i < collection_model->number_of_elements; i++)
 			{
-				float rectangle_height = calculateStickHeight(i); //calc height
+				float rectangle_height = calculateStickHeight(stick_pool[i]->data); //calc height
 
 				sf::Vector2f rectangle_size = sf::Vector2f(rectangle_width, rectangle_height);
 
-				sticks[i]->stick_view->initialize(rectangle_size, sf::Vector2f(0, 0), 0, collection_model->element_color);
+				stick_pool[i]->stick_view->initialize(rectangle_size, sf::Vector2f(0, 0), 0, collection_model->element_color);
 			}
 		}
 
 		void StickCollectionController::update()
 		{
-			processSortThreadState();
+			if (reset_pending) processPendingReset();
+			else processSortThreadState();
+			processHighlightExpiries();
+			if (sort_task_pending) ServiceLocator::getInstance()->getGraphicService()->requestRedraw(); // recording progress
+			if (operation_log_reader) processPlayback();
 			collection_view->update();
-			for (int i = 0; i < sticks.size(); i++) sticks[i]->stick_view->update();
+			if (!bar_renderer)
+				for (int i = 0; i < display_sticks.size(); i++) display_sticks[i]->stick_view->update();
 		}
 
 		
 
 		void StickCollectionController::render()
 		{
+			applyRecoloredSticks();
+
+			if (bar_renderer) bar_renderer->render(ServiceLocator::getInstance()->getGraphicService()->getRenderTarget());
+			else for (int i = 0; i < display_sticks.size(); i++) display_sticks[i]->stick_view->render();
 			collection_view->render();
-			for (int i = 0; i < sticks.size(); i++) sticks[i]->stick_view->render();
 		}
 
 		float StickCollectionController::calculateStickWidth()
 		{
-			float total_space = static_cast<float>(ServiceLocator::getInstance()->getGraphicService()->getGameWindow()->getSize().x);
+			float total_space = collection_model->collection_width;
 
 			// Calculate total spacing as 10% of the total space
 			float total_spacing = collection_model->space_percentage * total_space;
@@ -83,43 +144,148 @@ namespace Gameplay
 
 			// Calculate the width of each rectangle
 			float rectangle_width = remaining_space / collection_model->number_of_elements;
+			collection_model->element_width = rectangle_width;
 
 			return rectangle_width;
 		}
 
-		float StickCollectionController::calculateStickHeight(int array_pos)
+		// Generated keys lie in [0, number_of_elements), the largest possible key gets the full height.
+		float StickCollectionController::calculateStickHeight(int data)
 		{
-			return (static_cast<float>(array_pos + 1) / collection_model->number_of_elements) * collection_model->max_element_height;
+			return (static_cast<float>(data + 1) / collection_model->number_of_elements) * collection_model->max_element_height;
 		}
 
-		void StickCollectionController::updateStickPosition()
+		void StickCollectionController::updateStickHeights()
 		{
-			for (int i = 0; i < sticks.size(); i++)
+			if (bar_renderer)
 			{
-				
-				float x_position = (i * sticks[i]->stick_view->getSize().x) + ((i) * collection_model->elements_spacing);
-				float y_position = collection_model->element_y_position - sticks[i]->stick_view->getSize().y;
-			
-				sticks[i]->stick_view->setPosition(sf::Vector2f(x_position, y_position));
+				updateBars();
+				return;
+			}
+
+			for (Stick* stick : stick_pool)
+			{
+				stick->stick_view->setSize(sf::Vector2f(collection_model->element_width, calculateStickHeight(stick->data)));
 			}
 		}
 
+		// Every change to the displayed sticks ends here, so this is where the next frame is asked for.
+		void StickCollectionController::updateStickPosition()
+		{
+			if (!bar_renderer)
+				for (int i = 0; i < display_sticks.size(); i++) updateStickPosition(i);
+			ServiceLocator::getInstance()->getGraphicService()->requestRedraw();
+		}
+
 		void StickCollectionController::updateStickPosition(int i)
 		{
 		
-			float x_position = (i * sticks[i]->stick_view->getSize().x) + ((i)*collection_model->elements_spacing);
-			float y_position = collection_model->element_y_position - sticks[i]->stick_view->getSize().y;
+			float x_position = collection_model->collection_x_position + (i * collection_model->element_width) + ((i)*collection_model->elements_spacing);
+			float y_position = collection_model->element_y_position - calculateStickHeight(display_sticks[i]->data);
 
-			sticks[i]->stick_view->setPosition(sf::Vector2f(x_position, y_position));
+			display_sticks[i]->stick_view->setPosition(sf::Vector2f(x_position, y_position));
 			
 		}
 
-		void StickCollectionController::shuffleSticks()
+		// With shader rendering every change to a displayed stick is written to its bar; the views are left alone.
+		void StickCollectionController::updateBar(int i)
+		{
+			if (bar_renderer) bar_renderer->setBar(i, calculateStickHeight(display_sticks[i]->data) / collection_model->max_element_height, getShownColor(display_sticks[i]));
+		}
+
+		// A stick moved to display index i; its highlight moves along with it.
+		void StickCollectionController::updateDisplayStick(int i)
+		{
+			trackHighlight(i);
+			updateBar(i);
+		}
+
+		ElementColor StickCollectionController::getShownColor(const Stick* stick)
+		{
+			int lifetime = collection_model->highlight_lifetime_frames;
+			if (lifetime > 0 && display_frame - stick->highlight_frame >= static_cast<unsigned int>(lifetime)) return ElementColor::DEFAULT;
+
+			return stick->color;
+		}
+
+		void StickCollectionController::trackHighlight(int index)
+		{
+			const Stick* stick = display_sticks[index];
+			if (collection_model->highlight_lifetime_frames <= 0 || stick->color == ElementColor::DEFAULT) return;
+
+			highlight_expiries.push({ stick->highlight_frame + collection_model->highlight_lifetime_frames, stick->highlight_frame, index });
+		}
+
+		// An entry only counts if the same highlight is still on that index; moved or re-highlighted sticks have
+		// newer entries of their own.
+		void StickCollectionController::processHighlightExpiries()
+		{
+			display_frame++;
+
+			while (!highlight_expiries.empty() && highlight_expiries.top().due_frame <= display_frame)
+			{
+				HighlightExpiry expiry = highlight_expiries.top();
+				highlight_expiries.pop();
+
+				if (expiry.index >= display_sticks.size()) continue;
+				Stick* stick = display_sticks[expiry.index];
+				if (stick->highlight_frame != expiry.highlight_frame || stick->color == ElementColor::DEFAULT) continue;
+
+				if (bar_renderer) updateBar(expiry.index);
+				else queueRecolor(stick);
+				ServiceLocator::getInstance()->getGraphicService()->requestRedraw();
+			}
+		}
+
+		// A stick recolored many times between two renders is queued once and gets a single view write.
+		void StickCollectionController::queueRecolor(Stick* stick)
 		{
-			std::random_device device;
-			std::mt19937 random_engine(device());
+			if (stick->recolor_queued) return;
 
-			std::shuffle(sticks.begin(), sticks.end(), random_engine);
+			stick->recolor_queued = true;
+			recolored_sticks.push_back(stick);
+		}
+
+		void StickCollectionController::applyRecoloredSticks()
+		{
+			for (Stick* stick : recolored_sticks)
+			{
+				stick->stick_view->setFillColor(collection_model->getElementColor(getShownColor(stick)));
+				stick->recolor_queued = false;
+			}
+			recolored_sticks.clear();
+		}
+
+		void StickCollectionController::updateBars()
+		{
+			for (int i = 0; i < display_sticks.size(); i++) updateBar(i);
+		}
+
+		// The seed is drawn here, so getInputSettings() already describes the next input while the pool generates it.
+		void StickCollectionController::prepareInput()
+		{
+			if (input_keys.size() == stick_pool.size())
+			{
+				next_input_keys = input_keys;
+				return;
+			}
+			if (randomize_input_seed) input_settings.seed = InputGenerator::createRandomSeed();
+
+			InputSettings settings = input_settings;
+			next_input_keys.resize(stick_pool.size());
+			ServiceLocator::getInstance()->getTaskService()->submit([this, settings]() {
+				InputGenerator::generate(settings, next_input_keys.data(), next_input_keys.size());
+			}, Task::TaskPriority::NORMAL, &input_task);
+		}
+
+		// Sticks keep their id order, the generated keys decide their heights and so what the sort has to do.
+		void StickCollectionController::applyInput()
+		{
+			for (int i = 0; i < stick_pool.size(); i++) stick_pool[i]->data = next_input_keys[i];
+
+			sticks = stick_pool;
+			display_sticks = sticks;
+			updateStickHeights();
 			updateStickPosition();
 		}
 
@@ -128,52 +294,565 @@ namespace Gameplay
 			return a->data < b->data;
 		}
 
+		// Once the sort thread has produced the whole log, the display starts replaying it.
 		void StickCollectionController::processSortThreadState()
 		{
-			if (sort_thread.joinable() && isCollectionSorted()) {
-				sort_thread.join();
+			if (sort_task_pending && sort_thread_finished) {
+				ServiceLocator::getInstance()->getTaskService()->wait(sort_task);
+				sort_task_pending = false;
+				playRecordedLog();
+			}
+		}
+
+		void StickCollectionController::playRecordedLog()
+		{
+			// Logs recorded to a file have been flushed out, in-memory ones are handed over to the reader.
+			operation_log_writer->close();
+			std::vector<std::uint8_t> log_buffer = operation_log_writer->releaseBuffer();
+			stopRecording();
+
+			operation_log_reader = new OperationLogReader();
+			bool opened = log_buffer.empty() ? operation_log_reader->open(operation_log_record_path) : operation_log_reader->open(std::move(log_buffer));
+
+			if (!opened || !startPlayback())
+			{
+				stopPlayback();
 				sort_state = SortState::NOT_SORTING;
 			}
 		}
 
+		void StickCollectionController::processSortThread(void (StickCollectionController::*sort_function)())
+		{
+			std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+
+			(this->*sort_function)();
+			if (!sort_cancelled) verifySort();
+
+			// Flush the counters changed after the last delay, so a replay ends on the same totals.
+			recordStep(0);
+
+			sort_duration_microseconds.store(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time).count(), std::memory_order_relaxed);
+			sort_thread_finished.store(true, std::memory_order_release);
+		}
+
+		void StickCollectionController::cancelSortThread()
+		{
+			sort_cancelled = true;
+			if (sort_task_pending) ServiceLocator::getInstance()->getTaskService()->wait(sort_task);
+			sort_task_pending = false;
+			stopRecording();
+		}
+
+		void StickCollectionController::setFixedTimestep(bool enabled)
+		{
+			fixed_timestep = enabled;
+		}
+
+		// Playback only moves on simulated time, which the game loop advances in fixed steps (or by exactly one
+		// frame when exporting), so how long a frame took to render never changes what is shown.
+		void StickCollectionController::advanceSimulationTime(double milliseconds)
+		{
+			if (!operation_log_reader || playback_paused) return;
+
+			playback_time += milliseconds;
+		}
+
+		void StickCollectionController::swapSticks(int first, int second)
+		{
+			std::swap(sticks[first], sticks[second]);
+			recordOperation({ OperationType::SWAP, first, second });
+		}
+
+		// Every change is applied before it is recorded: a keyframe written by recordOperation() counts the operation,
+		// so its snapshot has to include it.
+		void StickCollectionController::setStick(int index, Stick* stick)
+		{
+			int previous_id = sticks[index]->id;
+			sticks[index] = stick;
+			recordOperation({ OperationType::WRITE, index, stick->id, previous_id });
+		}
+
+		void StickCollectionController::setStickColor(int index, ElementColor color)
+		{
+			ElementColor& stick_color = sort_colors[sticks[index]->id];
+			ElementColor previous_color = stick_color;
+			stick_color = color;
+			recordOperation({ OperationType::SET_COLOR, index, static_cast<int>(color), static_cast<int>(previous_color) });
+		}
+
+		void StickCollectionController::setMergeTreeNode(int node, int stick_id, bool lit)
+		{
+			int& node_state = sort_merge_tree_states[node];
+			int previous_state = node_state;
+			int state = encodeMergeTreeNode(stick_id, lit);
+			node_state = state;
+			recordOperation({ OperationType::MERGE_NODE, node, state, previous_state });
+		}
+
+		// 0 is an empty node, otherwise the stick id shifted up by one with the lit flag in the low bit.
+		int StickCollectionController::encodeMergeTreeNode(int stick_id, bool lit)
+		{
+			return stick_id < 0 ? 0 : (stick_id + 1) * 2 + (lit ? 1 : 0);
+		}
+
+		void StickCollectionController::playCompareSound(int index)
+		{
+			recordOperation({ OperationType::PLAY_SOUND, index });
+		}
+
+		void StickCollectionController::setOperationLogRecordPath(const std::string& path)
+		{
+			operation_log_record_path = path;
+		}
+
+		// Logs go to the record path when one is set, otherwise they only live in memory for the timeline.
+		void StickCollectionController::startRecording()
+		{
+			std::vector<int> element_data;
+			for (Stick* stick : stick_pool) element_data.push_back(stick->data);
+
+			operation_log_writer = new OperationLogWriter();
+			if (operation_log_record_path.empty())
+			{
+				operation_log_writer->openInMemory(sort_type, element_data, collection_model->operation_log_keyframe_interval);
+			}
+			else if (!operation_log_writer->open(operation_log_record_path, sort_type, element_data, collection_model->operation_log_keyframe_interval))
+			{
+				operation_log_writer->openInMemory(sort_type, element_data, collection_model->operation_log_keyframe_interval);
+			}
+
+			recorded_comparisons = number_of_comparisons;
+			recorded_array_access = number_of_array_access;
+			operation_log_writer->writeKeyframe(createKeyframe());
+		}
+
+		void StickCollectionController::stopRecording()
+		{
+			if (!operation_log_writer) return;
+
+			operation_log_writer->close();
+			delete (operation_log_writer);
+			operation_log_writer = nullptr;
+		}
+
+		void StickCollectionController::recordOperation(const Operation& operation)
+		{
+			if (!operation_log_writer) return;
+
+			operation_log_writer->writeOperation(operation);
+			if (operation_log_writer->needsKeyframe()) operation_log_writer->writeKeyframe(createKeyframe());
+		}
+
+		// Delays mark the visible steps of a sort; the counters are stored as deltas since the previous step.
+		void StickCollectionController::recordStep(long delay_in_ms)
+		{
+			if (!operation_log_writer) return;
+
+			Operation step = { OperationType::STEP, static_cast<int>(delay_in_ms), number_of_comparisons - recorded_comparisons, number_of_array_access - recorded_array_access };
+			recorded_comparisons = number_of_comparisons;
+			recorded_array_access = number_of_array_access;
+			recordOperation(step);
+			published_operation_count.store(operation_log_writer->getOperationCount(), std::memory_order_relaxed);
+		}
+
+		void StickCollectionController::recordOperationStep()
+		{
+			recordStep(collection_model->operation_delay);
+		}
+
+		void StickCollectionController::recordColorStep()
+		{
+			recordStep(collection_model->initial_color_delay);
+		}
+
+		// Playback counters only move by the STEP deltas, so a keyframe holds the counters as of the last step, not the
+		// live ones the sort has run up since.
+		OperationLogKeyframe StickCollectionController::createKeyframe()
+		{
+			OperationLogKeyframe keyframe;
+			keyframe.number_of_comparisons = recorded_comparisons;
+			keyframe.number_of_array_access = recorded_array_access;
+
+			for (Stick* stick : sticks)
+			{
+				keyframe.stick_ids.push_back(stick->id);
+				keyframe.colors.push_back(sort_colors[stick->id]);
+			}
+
+			return keyframe;
+		}
+
+		bool StickCollectionController::playOperationLog(const std::string& path, std::int64_t start_operation)
+		{
+			reset();
+			completeReset(); // the log's elements replace the new input, it must not land after them
+
+			operation_log_reader = new OperationLogReader();
+			if (!operation_log_reader->open(path) || !startPlayback())
+			{
+				stopPlayback();
+				return false;
+			}
+
+			return seekOperationLog(start_operation);
+		}
+
+		// Shows the log held by operation_log_reader from its first operation.
+		bool StickCollectionController::startPlayback()
+		{
+			if (operation_log_reader->getElementCount() != static_cast<int>(stick_pool.size()))
+			{
+				fprintf(stderr, "Operation log has %d elements, collection has %d\n", operation_log_reader->getElementCount(), static_cast<int>(stick_pool.size()));
+				return false;
+			}
+
+			const std::vector<int>& element_data = operation_log_reader->getElementData();
+			for (int i = 0; i < element_data.size(); i++) stick_pool[i]->data = element_data[i];
+			updateStickHeights();
+
+			sort_type = operation_log_reader->getSortType();
+			sort_state = SortState::SORTING;
+			skip_playback_delays = ServiceLocator::getInstance()->getGraphicService()->isHeadless() && !fixed_timestep;
+			current_operation_delay = skip_playback_delays ? 0 : collection_model->operation_delay;
+			playback_paused = false;
+			playback_reversed = false;
+			playback_time = 0;
+			playback_pending_delay = 0;
+
+			if (!restoreKeyframe(0)) return false;
+
+			updateStickPosition();
+			return true;
+		}
+
+		bool StickCollectionController::restoreKeyframe(std::int64_t operation_index)
+		{
+			OperationLogKeyframe keyframe;
+			if (!operation_log_reader->seekKeyframe(operation_index, keyframe, playback_offset)) return false;
+
+			applyKeyframe(keyframe);
+			playback_operation_index = keyframe.operation_index;
+			return true;
+		}
+
+		// Nearby targets are reached by walking the log in either direction, distant ones by restoring
+		// the closest keyframe first, so a seek never replays more than one keyframe interval.
+		bool StickCollectionController::seekOperationLog(std::int64_t operation_index)
+		{
+			if (!operation_log_reader) return false;
+
+			operation_index = std::max<std::int64_t>(0, std::min(operation_index, operation_log_reader->getOperationCount()));
+
+			std::int64_t distance = operation_index - playback_operation_index;
+			if ((distance > operation_log_reader->getKeyframeInterval() || -distance > operation_log_reader->getKeyframeInterval()) &&
+				!restoreKeyframe(operation_index)) return false;
+
+			Operation operation;
+			while (playback_operation_index < operation_index && operation_log_reader->readOperation(playback_offset, operation))
+			{
+				applyOperation(operation, false);
+				playback_operation_index++;
+			}
+
+			while (playback_operation_index > operation_index && operation_log_reader->readPreviousOperation(playback_offset, operation))
+			{
+				undoOperation(operation, false);
+				playback_operation_index--;
+			}
+
+			playback_pending_delay = 0;
+			updateStickPosition();
+			return true;
+		}
+
+		// Timed playback applies at most max_playback_operations_per_frame; time it could not catch up on is dropped
+		// rather than owed, so a burst of zero-delay steps slows the replay down instead of stalling the frame.
+		void StickCollectionController::processPlayback()
+		{
+			if (playback_paused) return;
+
+			int applied_steps = 0;
+			std::int64_t first_operation_index = playback_operation_index;
+			bool over_budget = false;
+
+			while (skip_playback_delays ? applied_steps < collection_model->max_skipped_playback_steps : playback_pending_delay <= playback_time)
+			{
+				over_budget = !skip_playback_delays &&
+					std::abs(playback_operation_index - first_operation_index) >= collection_model->max_playback_operations_per_frame;
+				if (over_budget) break;
+
+				if (!skip_playback_delays) playback_time -= playback_pending_delay;
+				playback_pending_delay = 0;
+
+				long delay_in_ms = 0;
+				bool stepped = playback_reversed ? stepPlaybackBackward(delay_in_ms, !skip_playback_delays) : stepPlaybackForward(delay_in_ms, !skip_playback_delays);
+
+				if (!stepped)
+				{
+					finishPlayback();
+					break;
+				}
+
+				playback_pending_delay = delay_in_ms;
+				applied_steps++;
+			}
+
+			if (over_budget) playback_time = std::min(playback_time, playback_pending_delay);
+			if (applied_steps > 0) updateStickPosition();
+		}
+
+		// Reaching either end of the log pauses the timeline, it stays open for scrubbing.
+		void StickCollectionController::finishPlayback()
+		{
+			playback_paused = true;
+			playback_time = 0;
+			playback_pending_delay = 0;
+			sort_state = SortState::NOT_SORTING;
+		}
+
+		// Applies operations up to and including the next STEP, so the display lands on the next visible state.
+		bool StickCollectionController::stepPlaybackForward(long& delay_in_ms, bool play_sound)
+		{
+			Operation operation;
+			bool stepped = false;
+
+			while (operation_log_reader->readOperation(playback_offset, operation))
+			{
+				applyOperation(operation, play_sound);
+				playback_operation_index++;
+				stepped = true;
+
+				if (operation.type == OperationType::STEP)
+				{
+					delay_in_ms = operation.first;
+					break;
+				}
+			}
+
+			return stepped;
+		}
+
+		// Undoes the previous STEP and everything after the one before it; the mirror image of stepPlaybackForward.
+		bool StickCollectionController::stepPlaybackBackward(long& delay_in_ms, bool play_sound)
+		{
+			Operation operation;
+			if (!operation_log_reader->readPreviousOperation(playback_offset, operation)) return false;
+
+			undoOperation(operation, play_sound);
+			playback_operation_index--;
+			if (operation.type == OperationType::STEP) delay_in_ms = operation.first;
+
+			std::size_t offset = playback_offset;
+			while (operation_log_reader->readPreviousOperation(offset, operation) && operation.type != OperationType::STEP)
+			{
+				undoOperation(operation, play_sound);
+				playback_operation_index--;
+				playback_offset = offset;
+			}
+
+			return true;
+		}
+
+		void StickCollectionController::applyOperation(const Operation& operation, bool play_sound)
+		{
+			int element_count = static_cast<int>(display_sticks.size());
+			if (operation.first < 0 || operation.first >= element_count) return;
+
+			switch (operation.type)
+			{
+			case OperationType::STEP:
+				playback_comparisons += operation.second;
+				playback_array_access += operation.third;
+				break;
+			case OperationType::SWAP:
+				if (operation.second >= element_count) break;
+				std::swap(display_sticks[operation.first], display_sticks[operation.second]);
+				updateDisplayStick(operation.first);
+				updateDisplayStick(operation.second);
+				break;
+			case OperationType::WRITE:
+				if (operation.second >= element_count) break;
+				display_sticks[operation.first] = stick_pool[operation.second];
+				updateDisplayStick(operation.first);
+				break;
+			case OperationType::SET_COLOR:
+				setDisplayStickColor(operation.first, static_cast<ElementColor>(operation.second));
+				break;
+			case OperationType::MERGE_NODE:
+				setDisplayMergeTreeNode(operation.first, operation.second);
+				break;
+			case OperationType::PLAY_SOUND:
+				if (play_sound && sound_enabled)
+					ServiceLocator::getInstance()->getSoundService()->playTone(static_cast<float>(display_sticks[operation.first]->data + 1) / display_sticks.size());
+				break;
+			default:
+				break;
+			}
+		}
+
+		void StickCollectionController::undoOperation(const Operation& operation, bool play_sound)
+		{
+			int element_count = static_cast<int>(display_sticks.size());
+			if (operation.first < 0 || operation.first >= element_count) return;
+
+			switch (operation.type)
+			{
+			case OperationType::STEP:
+				playback_comparisons -= operation.second;
+				playback_array_access -= operation.third;
+				break;
+			case OperationType::WRITE:
+				if (operation.third >= element_count) break;
+				display_sticks[operation.first] = stick_pool[operation.third];
+				updateDisplayStick(operation.first);
+				break;
+			case OperationType::SET_COLOR:
+				setDisplayStickColor(operation.first, static_cast<ElementColor>(operation.third));
+				break;
+			case OperationType::MERGE_NODE:
+				setDisplayMergeTreeNode(operation.first, operation.third);
+				break;
+			default:
+				// Swaps are their own inverse, and sounds play the same in either direction.
+				applyOperation(operation, play_sound);
+				break;
+			}
+		}
+
+		void StickCollectionController::setDisplayStickColor(int index, ElementColor color)
+		{
+			Stick* stick = display_sticks[index];
+			stick->color = color;
+			stick->highlight_frame = display_frame;
+			trackHighlight(index);
+
+			if (bar_renderer) updateBar(index);
+			else queueRecolor(stick);
+		}
+
+		void StickCollectionController::setDisplayMergeTreeNode(int node, int state)
+		{
+			if (node < 0 || node >= merge_tree_states.size()) return;
+
+			int stick_id = state / 2 - 1;
+			merge_tree_states[node] = state;
+
+			if (stick_id < 0 || stick_id >= stick_pool.size()) collection_view->hideMergeTreeNode(node);
+			else collection_view->showMergeTreeNode(node, static_cast<float>(stick_pool[stick_id]->data + 1) / stick_pool.size(), (state & 1) != 0);
+		}
+
+		void StickCollectionController::clearDisplayMergeTree()
+		{
+			for (int i = 0; i < merge_tree_states.size(); i++) setDisplayMergeTreeNode(i, 0);
+		}
+
+		// Keyframes do not store the merge tree, it is rebuilt by the next merge step.
+		void StickCollectionController::applyKeyframe(const OperationLogKeyframe& keyframe)
+		{
+			clearDisplayMergeTree();
+
+			for (int i = 0; i < display_sticks.size() && i < keyframe.stick_ids.size(); i++)
+			{
+				if (keyframe.stick_ids[i] < 0 || keyframe.stick_ids[i] >= stick_pool.size()) continue;
+
+				display_sticks[i] = stick_pool[keyframe.stick_ids[i]];
+				setDisplayStickColor(i, keyframe.colors[i]);
+			}
+
+			playback_comparisons = static_cast<int>(keyframe.number_of_comparisons);
+			playback_array_access = static_cast<int>(keyframe.number_of_array_access);
+		}
+
+		void StickCollectionController::stopPlayback()
+		{
+			if (!operation_log_reader) return;
+
+			operation_log_reader->close();
+			delete (operation_log_reader);
+			operation_log_reader = nullptr;
+			playback_paused = false;
+			playback_reversed = false;
+		}
+
+		bool StickCollectionController::hasTimeline() { return operation_log_reader != nullptr; }
+
+		// Resuming at the end of the log in the current direction starts over from the other end.
+		void StickCollectionController::setPlaybackPaused(bool paused)
+		{
+			if (!operation_log_reader) return;
+
+			if (!paused)
+			{
+				if (!playback_reversed && playback_operation_index >= operation_log_reader->getOperationCount()) seekOperationLog(0);
+				else if (playback_reversed && playback_operation_index <= 0) seekOperationLog(operation_log_reader->getOperationCount());
+			}
+
+			playback_paused = paused;
+			sort_state = paused ? SortState::NOT_SORTING : SortState::SORTING;
+		}
+
+		bool StickCollectionController::isPlaybackPaused() { return playback_paused; }
+
+		void StickCollectionController::setPlaybackReversed(bool reversed)
+		{
+			playback_reversed = reversed;
+			playback_pending_delay = 0;
+		}
+
+		bool StickCollectionController::isPlaybackReversed() { return playback_reversed; }
+
+		void StickCollectionController::stepPlayback(bool forward)
+		{
+			if (!operation_log_reader) return;
+
+			setPlaybackPaused(true);
+
+			long delay_in_ms = 0;
+			if (forward) stepPlaybackForward(delay_in_ms, true);
+			else stepPlaybackBackward(delay_in_ms, true);
+
+			updateStickPosition();
+		}
+
+		std::int64_t StickCollectionController::getPlaybackOperationIndex() { return operation_log_reader ? playback_operation_index : 0; }
+
+		std::int64_t StickCollectionController::getPlaybackOperationCount() { return operation_log_reader ? operation_log_reader->getOperationCount() : 0; }
+
 		void StickCollectionController::processBubbleSort() {
-			Sound::SoundService* sound = Global::ServiceLocator::getInstance()->getSoundService();
 
 			for (int j = 0; j < sticks.size(); j++) {   // Loop through the sticks array
-				if (sort_state == SortState::NOT_SORTING) { break; }   // Check if sorting has stopped or been interrupted
+				if (sort_cancelled) { break; }   // Check if sorting has stopped or been interrupted
 
 				bool swapped = false;  // To track if a swap was made
 
 				for (int i = 1; i < sticks.size() - j; i++) {    // Loop through the array, reducing the range each pass
-					if (sort_state == SortState::NOT_SORTING) { break; }      // Check if sorting has stopped or been interrupted
+					if (sort_cancelled) { break; }      // Check if sorting has stopped or been interrupted
 
 					// Increment the number of array accesses and comparisons
 					number_of_array_access += 2;
 					number_of_comparisons++;
 
-					sound->playSound(Sound::SoundType::COMPARE_SFX);      // Play the compare sound effect
+					playCompareSound(i);      // Play the compare sound effect
 
 					// Set the current sticks to the processing color
-					sticks[i - 1]->stick_view->setFillColor(collection_model->processing_element_color);
-					sticks[i]->stick_view->setFillColor(collection_model->processing_element_color);
+					setStickColor(i - 1, ElementColor::PROCESSING);
+					setStickColor(i, ElementColor::PROCESSING);
 
 					if (sticks[i - 1]->data > sticks[i]->data) {      // Check if the current stick is greater than the next stick
 						// Swap the sticks if necessary
-						std::swap(sticks[i - 1], sticks[i]);
+						swapSticks(i - 1, i);
 						swapped = true;  // Set swapped to true if there was a swap
 					}
 
-					std::this_thread::sleep_for(std::chrono::milliseconds(current_operation_delay));
+					recordOperationStep();
 
 					// Reset the stick colors
-					sticks[i - 1]->stick_view->setFillColor(collection_model->element_color);
-					sticks[i]->stick_view->setFillColor(collection_model->element_color);
-
-					updateStickPosition();
+					setStickColor(i - 1, ElementColor::DEFAULT);
+					setStickColor(i, ElementColor::DEFAULT);
 				}
 
 				if (sticks.size() - j - 1 >= 0) {    // Set the last sorted stick to the placement position color
-					sticks[sticks.size() - j - 1]->stick_view->setFillColor(collection_model->placement_position_element_color);
+					setStickColor(sticks.size() - j - 1, ElementColor::PLACEMENT_POSITION);
 				}
 
 				if (!swapped) { break; }    // If no swaps were made, the array is already sorted
@@ -183,50 +862,47 @@ namespace Gameplay
 
 		void StickCollectionController::processInsertionSort()
 		{
-			SoundService* sound = Global::ServiceLocator::getInstance()->getSoundService();
 
 			for (int i = 1; i < sticks.size(); ++i)
 			{
 
-				if (sort_state == SortState::NOT_SORTING) { break; }
+				if (sort_cancelled) { break; }
 
 				int j = i - 1;
 				Stick* key = sticks[i];
 				number_of_array_access++; // Access for key stick
 
 
-				key->stick_view->setFillColor(collection_model->processing_element_color); // Current key is red
+				setStickColor(i, ElementColor::PROCESSING); // Current key is red
 
-				std::this_thread::sleep_for(std::chrono::milliseconds(current_operation_delay));
+				recordOperationStep();
 
 				while (j >= 0 && sticks[j]->data > key->data)
 				{
 
-					if (sort_state == SortState::NOT_SORTING) { break; }
+					if (sort_cancelled) { break; }
 
 					number_of_comparisons++;
 					number_of_array_access++;
 
-					sticks[j + 1] = sticks[j];
+					setStick(j + 1, sticks[j]);
 					number_of_array_access++; // Access for assigning sticks[j] to sticks[j + 1]
-					sticks[j + 1]->stick_view->setFillColor(collection_model->processing_element_color); // Mark as being compared
+					setStickColor(j + 1, ElementColor::PROCESSING); // Mark as being compared
 					j--;
-					sound->playSound(SoundType::COMPARE_SFX);
-					updateStickPosition(); // Visual update
+					playCompareSound(j + 2);
 
-					std::this_thread::sleep_for(std::chrono::milliseconds(current_operation_delay));
+					recordOperationStep();
 
-					sticks[j + 2]->stick_view->setFillColor(collection_model->selected_element_color); // Mark as being compared
+					setStickColor(j + 2, ElementColor::SELECTED); // Mark as being compared
 
 				}
 
-				sticks[j + 1] = key;
+				setStick(j + 1, key);
 				number_of_array_access++;
-				sticks[j + 1]->stick_view->setFillColor(collection_model->temporary_processing_color); // Placed key is green indicating it's sorted
-				sound->playSound(SoundType::COMPARE_SFX);
-				updateStickPosition(); // Final visual update for this iteration
-				std::this_thread::sleep_for(std::chrono::milliseconds(current_operation_delay));
-				sticks[j + 1]->stick_view->setFillColor(collection_model->selected_element_color); // Placed key is green indicating it's sorted
+				setStickColor(j + 1, ElementColor::TEMPORARY_PROCESSING); // Placed key is green indicating it's sorted
+				playCompareSound(j + 1);
+				recordOperationStep();
+				setStickColor(j + 1, ElementColor::SELECTED); // Placed key is green indicating it's sorted
 			}
 			setCompletedColor();
 
@@ -234,40 +910,38 @@ namespace Gameplay
 
 		void StickCollectionController::processSelectionSort()
 		{
-			Sound::SoundService* sound = Global::ServiceLocator::getInstance()->getSoundService();
 
 			for (int j = 0; j < sticks.size(); j++) {  
-				if (sort_state == SortState::NOT_SORTING) { break; }  
+				if (sort_cancelled) { break; }  
 				int minIndex = j;
-				sticks[minIndex]->stick_view->setFillColor(collection_model->processing_element_color);
+				setStickColor(minIndex, ElementColor::PROCESSING);
 				for (int i = minIndex; i < sticks.size() ; i++) {    
-					if (sort_state == SortState::NOT_SORTING) { break; } 
+					if (sort_cancelled) { break; } 
 
 				
 					number_of_array_access += 2;
 					number_of_comparisons++;
 
-					sound->playSound(Sound::SoundType::COMPARE_SFX); 
+					playCompareSound(i); 
 
-					sticks[i]->stick_view->setFillColor(collection_model->processing_element_color);
+					setStickColor(i, ElementColor::PROCESSING);
 
-					std::this_thread::sleep_for(std::chrono::milliseconds(current_operation_delay));
+					recordOperationStep();
 
 					if (sticks[i]->data < sticks[minIndex]->data) {
-						sticks[minIndex]->stick_view->setFillColor(collection_model->element_color);
+						setStickColor(minIndex, ElementColor::DEFAULT);
 						minIndex = i;
-						sticks[minIndex]->stick_view->setFillColor(collection_model->temporary_processing_color);
+						setStickColor(minIndex, ElementColor::TEMPORARY_PROCESSING);
 					}
 					else {
-						sticks[i]->stick_view->setFillColor(collection_model->element_color);
+						setStickColor(i, ElementColor::DEFAULT);
 					}
 					
 				
 				}
-				std::swap(sticks[j], sticks[minIndex]);
+				swapSticks(j, minIndex);
 				number_of_array_access += 2;
-				sticks[j]->stick_view->setFillColor(collection_model->placement_position_element_color);
-				updateStickPosition();
+				setStickColor(j, ElementColor::PLACEMENT_POSITION);
 			}
 			setCompletedColor();
 		}
@@ -278,6 +952,12 @@ namespace Gameplay
 			setCompletedColor();
 		}
 
+		void StickCollectionController::processMultiwayMergeSort()
+		{
+			multiwayMergeSort(0, static_cast<int>(sticks.size()) - 1);
+			setCompletedColor();
+		}
+
 		void StickCollectionController::processQuickSort()
 		{
 			quickSort(0, sticks.size() - 1);
@@ -291,15 +971,14 @@ namespace Gameplay
 		}
 
 		void StickCollectionController::countSort(int exponent) {
-			Sound::SoundService* sound = Global::ServiceLocator::getInstance()->getSoundService();
 			std::vector<Stick*> ans(sticks.size(),0);
 			std::vector<int> count(sticks.size(),0);
 			for (int i = 0; i < sticks.size(); i++) {
-				sticks[i]->stick_view->setFillColor(collection_model->processing_element_color);
+				setStickColor(i, ElementColor::PROCESSING);
 				count[(sticks[i]->data / exponent) % 10]++;
-				sound->playSound(Sound::SoundType::COMPARE_SFX);
-				std::this_thread::sleep_for(std::chrono::milliseconds(current_operation_delay));
-				sticks[i]->stick_view->setFillColor(collection_model->element_color);
+				playCompareSound(i);
+				recordOperationStep();
+				setStickColor(i, ElementColor::DEFAULT);
 				number_of_array_access ++;
 			}
 
@@ -309,16 +988,15 @@ namespace Gameplay
 
 			for (int i = sticks.size() - 1; i >= 0; i--) {
 				int index = --count[(sticks[i]->data / exponent) % 10];
-				sticks[i]->stick_view->setFillColor(collection_model->temporary_processing_color);
+				setStickColor(i, ElementColor::TEMPORARY_PROCESSING);
 				ans[index] = sticks[i];
 				number_of_array_access++;
 			}
 			for (int i = 0; i < sticks.size(); i++) {
-				sticks[i] = ans[i];
-				sticks[i]->stick_view->setFillColor(collection_model->placement_position_element_color);
-				updateStickPosition(i);
-				sound->playSound(Sound::SoundType::COMPARE_SFX);
-				std::this_thread::sleep_for(std::chrono::milliseconds(current_operation_delay));
+				setStick(i, ans[i]);
+				setStickColor(i, ElementColor::PLACEMENT_POSITION);
+				playCompareSound(i);
+				recordOperationStep();
 			}
 		}
 
@@ -329,7 +1007,7 @@ namespace Gameplay
 					maxNumber = sticks[i]->data;
 				}
 			}
-			for (int exponent = 1; maxNumber/exponent >0; exponent *=10) {
+			for (int exponent = 1; maxNumber/exponent >0 && !sort_cancelled; exponent *=10) {
 				countSort( exponent);
 			}
 		}
@@ -338,33 +1016,30 @@ namespace Gameplay
 
 		int StickCollectionController::partition(int low, int high) {
 
-			Sound::SoundService* sound = Global::ServiceLocator::getInstance()->getSoundService();
 			Stick* pivot = sticks[high];
-			sticks[high]->stick_view->setFillColor(collection_model->selected_element_color);
+			setStickColor(high, ElementColor::SELECTED);
 			int swapIndex = low - 1;
 			for (int currentIndex = low; currentIndex < high; currentIndex++) {
 				number_of_array_access += 2;
 				number_of_comparisons++;
-				sticks[currentIndex]->stick_view->setFillColor(collection_model->processing_element_color);
+				setStickColor(currentIndex, ElementColor::PROCESSING);
 				if (sticks[currentIndex]->data <= pivot->data) {
 					swapIndex++;
-					std::swap(sticks[swapIndex], sticks[currentIndex]);
-					updateStickPosition();
-					sound->playSound(Sound::SoundType::COMPARE_SFX);
-					std::this_thread::sleep_for(std::chrono::milliseconds(current_operation_delay));
+					swapSticks(swapIndex, currentIndex);
+					playCompareSound(swapIndex);
+					recordOperationStep();
 				}
 				else {
-					sticks[currentIndex]->stick_view->setFillColor(collection_model->element_color);
+					setStickColor(currentIndex, ElementColor::DEFAULT);
 				}
 			}
-			std::swap(sticks[swapIndex + 1], sticks[high]);
+			swapSticks(swapIndex + 1, high);
 			number_of_array_access += 2;
-			updateStickPosition();
 			return swapIndex + 1;
 		}
 
 		void StickCollectionController::quickSort( int low, int high) {
-			if (low < high) {
+			if (low < high && !sort_cancelled) {
 				int pivotIndex = partition(low, high);
 				quickSort( low, pivotIndex - 1);
 				quickSort(pivotIndex + 1, high);
@@ -374,7 +1049,6 @@ namespace Gameplay
 		// Out-of-Place Merge function
 		void StickCollectionController::merge(int left, int mid, int right)
 		{
-			SoundService* sound = Global::ServiceLocator::getInstance()->getSoundService();
 
 			std::vector<Stick*> temp(right - left + 1);
 			int k = 0;
@@ -383,8 +1057,7 @@ namespace Gameplay
 			for (int index = left; index <= right; ++index) {
 				temp[k++] = sticks[index];
 				number_of_array_access++;
-				sticks[index]->stick_view->setFillColor(collection_model->temporary_processing_color);
-				updateStickPosition();
+				setStickColor(index, ElementColor::TEMPORARY_PROCESSING);
 			}
 
 			int i = 0;  // Start of the first half in temp
@@ -396,18 +1069,17 @@ namespace Gameplay
 				number_of_comparisons++;
 				number_of_array_access += 2;
 				if (temp[i]->data <= temp[j]->data) {
-					sticks[k] = temp[i++];
+					setStick(k, temp[i++]);
 					number_of_array_access++;
 				}
 				else {
-					sticks[k] = temp[j++];
+					setStick(k, temp[j++]);
 					number_of_array_access++;
 				}
 
-				sound->playSound(SoundType::COMPARE_SFX);
-				sticks[k]->stick_view->setFillColor(collection_model->processing_element_color);
-				updateStickPosition();  // Immediate update after assignment
-				std::this_thread::sleep_for(std::chrono::milliseconds(current_operation_delay));
+				playCompareSound(k);
+				setStickColor(k, ElementColor::PROCESSING);
+				recordOperationStep();
 
 				k++;
 			}
@@ -416,16 +1088,15 @@ namespace Gameplay
 			while (i < mid - left + 1 || j < temp.size()) {
 				number_of_array_access++;
 				if (i < mid - left + 1) {
-					sticks[k] = temp[i++];
+					setStick(k, temp[i++]);
 				}
 				else {
-					sticks[k] = temp[j++];
+					setStick(k, temp[j++]);
 				}
 
-				sound->playSound(SoundType::COMPARE_SFX);
-				sticks[k]->stick_view->setFillColor(collection_model->processing_element_color);
-				updateStickPosition();  // Immediate update
-				std::this_thread::sleep_for(std::chrono::milliseconds(current_operation_delay));
+				playCompareSound(k);
+				setStickColor(k, ElementColor::PROCESSING);
+				recordOperationStep();
 
 				k++;
 			}
@@ -434,7 +1105,7 @@ namespace Gameplay
 		// Out-of-Place Merge Sort function
 		void StickCollectionController::mergeSort(int left, int right)
 		{
-			if (left >= right) return;
+			if (left >= right || sort_cancelled) return;
 			int mid = left + (right - left) / 2;
 
 			mergeSort(left, mid);
@@ -442,6 +1113,89 @@ namespace Gameplay
 			merge(left, mid, right);
 		}
 
+		// Cuts the range into multiway_merge_fan_in runs of nearly equal length and merges them in a single pass.
+		void StickCollectionController::multiwayMergeSort(int left, int right)
+		{
+			if (left >= right || sort_cancelled) return;
+
+			int length = right - left + 1;
+			int run_count = std::min(collection_model->multiway_merge_fan_in, length);
+
+			std::vector<int> run_starts;
+			for (int i = 0; i <= run_count; i++) run_starts.push_back(left + length * i / run_count);
+
+			for (int i = 0; i < run_count; i++) multiwayMergeSort(run_starts[i], run_starts[i + 1] - 1);
+			multiwayMerge(run_starts);
+		}
+
+		// Run heads play off in a loser tree. Each output replays only the path above the run it came from,
+		// which is what lights up in the tree drawn by the view.
+		void StickCollectionController::multiwayMerge(const std::vector<int>& run_starts)
+		{
+			if (sort_cancelled) return;
+
+			int left = run_starts.front();
+			int run_count = static_cast<int>(run_starts.size()) - 1;
+
+			std::vector<Stick*> temp(sticks.begin() + left, sticks.begin() + run_starts.back());
+			for (int index = left; index < run_starts.back(); ++index)
+			{
+				number_of_array_access++;
+				setStickColor(index, ElementColor::TEMPORARY_PROCESSING);
+			}
+
+			LoserTree<Stick*, StickDataLess> tree(run_count, StickDataLess{ &number_of_comparisons });
+			std::vector<int> run_positions(run_count);
+			for (int i = 0; i < run_count; i++)
+			{
+				run_positions[i] = run_starts[i] - left;
+				tree.setSourceKey(i, temp[run_positions[i]]);
+				number_of_array_access++;
+			}
+			tree.build();
+
+			auto showTree = [&](int replayed_source) {
+				std::vector<bool> lit(collection_model->multiway_merge_fan_in, replayed_source < 0);
+				if (replayed_source >= 0)
+				{
+					lit[0] = true;
+					for (int node = tree.getLeafParent(replayed_source); node > 0; node /= 2) lit[node] = true;
+				}
+
+				for (int node = 0; node < lit.size(); node++)
+				{
+					bool has_key = node < run_count && !tree.isNodeEmpty(node);
+					setMergeTreeNode(node, has_key ? tree.getNodeKey(node)->id : -1, has_key && lit[node]);
+				}
+			};
+
+			showTree(-1);
+			recordColorStep();
+
+			for (int k = left; !tree.isEmpty() && !sort_cancelled; k++)
+			{
+				int source = tree.getWinnerSource();
+				setStick(k, tree.getWinnerKey());
+				number_of_array_access++;
+
+				int& position = run_positions[source];
+				position++;
+				if (position < run_starts[source + 1] - left)
+				{
+					tree.replaceWinner(temp[position]);
+					number_of_array_access++;
+				}
+				else tree.removeWinner();
+
+				playCompareSound(k);
+				setStickColor(k, ElementColor::PROCESSING);
+				showTree(source);
+				recordOperationStep();
+			}
+
+			for (int node = 0; node < collection_model->multiway_merge_fan_in; node++) setMergeTreeNode(node, -1, false);
+		}
+
 		void StickCollectionController::inPlaceMergeSort(int left, int right) {
 			if (left < right) {
 				int middle = left + (right - left) / 2;
@@ -456,7 +1210,6 @@ namespace Gameplay
 		}
 
 		void StickCollectionController::inPlaceMerge(int left, int mid, int right) {
-			Sound::SoundService* sound = Global::ServiceLocator::getInstance()->getSoundService();
 
 			int start2 = mid + 1;
 			if (sticks[mid]->data <= sticks[start2]->data) {
@@ -475,112 +1228,304 @@ namespace Gameplay
 					Stick* swpaData = sticks[start2];
 					int index = start2;
 					while (index != left) {
-						sticks[index] = sticks[index - 1];
+						setStick(index, sticks[index - 1]);
 						number_of_array_access += 2;
 						index--;
 					}
-					sticks[left] = swpaData;
+					setStick(left, swpaData);
 					number_of_array_access++;
 					left++;
 					mid++;
 					start2++;
-					updateStickPosition();
 				}
 				
-				sound->playSound(Sound::SoundType::COMPARE_SFX);
-				sticks[left-1]->stick_view->setFillColor(collection_model->processing_element_color);
-				std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+				playCompareSound(left - 1);
+				setStickColor(left-1, ElementColor::PROCESSING);
+				recordOperationStep();
 			}
 			
 		}
 
 		void StickCollectionController::setCompletedColor() {
 			for (int k = 0; k < sticks.size(); k++) {
-				if (sort_state == SortState::NOT_SORTING) { break; } // Check if sorting is stoped or completed
-				sticks[k]->stick_view->setFillColor(collection_model->element_color);
+				if (sort_cancelled) { break; } // Check if sorting is stoped or completed
+				setStickColor(k, ElementColor::DEFAULT);
 			}
-			SoundService* sound = Global::ServiceLocator::getInstance()->getSoundService();
 			for (int i = 0; i < sticks.size(); ++i) {
-				if (sort_state == SortState::NOT_SORTING) { break; }  // Check if sorting is stoped or completed
-				sound->playSound(SoundType::COMPARE_SFX);
-				sticks[i]->stick_view->setFillColor(collection_model->placement_position_element_color);
-				std::this_thread::sleep_for(std::chrono::milliseconds(color_delay));
+				if (sort_cancelled) { break; }  // Check if sorting is stoped or completed
+				playCompareSound(i);
+				setStickColor(i, ElementColor::PLACEMENT_POSITION);
+				recordColorStep();
 			}
 			
 		}
 
 		void StickCollectionController::resetSticksColor()
 		{
-			for (int i = 0; i < sticks.size(); i++) sticks[i]->stick_view->setFillColor(collection_model->element_color);
+			sort_colors.assign(stick_pool.size(), ElementColor::DEFAULT);
+			for (int i = 0; i < display_sticks.size(); i++) setDisplayStickColor(i, ElementColor::DEFAULT);
+			clearDisplayMergeTree();
 		}
 
 		void StickCollectionController::resetVariables()
 		{
 			number_of_comparisons = 0;
 			number_of_array_access = 0;
+			playback_comparisons = 0;
+			playback_array_access = 0;
 		}
 
+		// Returns right away: the sticks keep showing the old input until update() finds the sort stopped and the
+		// next keys generated.
 		void StickCollectionController::reset()
 		{
 			current_operation_delay = 0;
-			color_delay = 0;
-			if (sort_thread.joinable()) sort_thread.join();
+			sort_cancelled = true;
+			stopPlayback();
 			sort_state = SortState::NOT_SORTING;
-			shuffleSticks();
+
+			ServiceLocator::getInstance()->getTaskService()->wait(input_task); // only busy when resetting twice in a row
+			prepareInput();
+			reset_pending = true;
+		}
+
+		void StickCollectionController::processPendingReset()
+		{
+			if (sort_task_pending && !sort_thread_finished.load(std::memory_order_acquire)) return;
+			if (!input_task.isIdle()) return;
+
+			completeReset();
+		}
+
+		// Blocks when called before both are done, e.g. at startup or when a sort is started straight after a reset.
+		void StickCollectionController::completeReset()
+		{
+			cancelSortThread();
+			ServiceLocator::getInstance()->getTaskService()->wait(input_task);
+			reset_pending = false;
+
+			applyInput();
 			resetSticksColor();
 			resetVariables();
 		}
 
 		void StickCollectionController::sortElements(SortType sort_type)
 		{
+			if (reset_pending) completeReset();
+			cancelSortThread();
+
+			// The sort starts from whatever is on screen, including a timeline that was scrubbed part way.
+			sticks = display_sticks;
+			for (Stick* stick : sticks) sort_colors[stick->id] = stick->color;
+			sort_merge_tree_states = merge_tree_states;
+			verification_input_keys.clear();
+			verification_start_positions.assign(stick_pool.size(), 0);
+			for (int i = 0; i < sticks.size(); i++)
+			{
+				verification_input_keys.push_back(sticks[i]->data);
+				verification_start_positions[sticks[i]->id] = i;
+			}
+			sort_verification = SortVerification();
+			number_of_comparisons = playback_comparisons;
+			number_of_array_access = playback_array_access;
+			stopPlayback();
+
 			sort_state = SortState::SORTING;
-			current_operation_delay = collection_model->operation_delay;
+			sort_cancelled = false;
+			published_operation_count = 0;
+			sort_duration_microseconds = 0;
 			this->sort_type = sort_type;
 
+			startRecording();
+
+			void (StickCollectionController::*sort_function)() = nullptr;
+
 			switch (sort_type)
 			{
 			case Gameplay::Collection::SortType::BUBBLE_SORT:
-				sort_thread = std::thread(&StickCollectionController::processBubbleSort, this);
+				sort_function = &StickCollectionController::processBubbleSort;
 				break;
 			case Gameplay::Collection::SortType::INSERTION_SORT:
-				sort_thread = std::thread(&StickCollectionController::processInsertionSort, this);
+				sort_function = &StickCollectionController::processInsertionSort;
 				break;
 			case Gameplay::Collection::SortType::SELECTION_SORT:
-				sort_thread = std::thread(&StickCollectionController::processSelectionSort, this);
+				sort_function = &StickCollectionController::processSelectionSort;
+				break;
 			case Gameplay::Collection::SortType::MERGE_SORT:
-				sort_thread = std::thread(&StickCollectionController::processMergeSort, this);
+				sort_function = &StickCollectionController::processMergeSort;
 				break;
 			case Gameplay::Collection::SortType::QUICK_SORT:
-				sort_thread = std::thread(&StickCollectionController::processQuickSort, this);
+				sort_function = &StickCollectionController::processQuickSort;
+				break;
 			case Gameplay::Collection::SortType::RADIX_SORT:
-				sort_thread = std::thread(&StickCollectionController::processRadixSort, this);
+				sort_function = &StickCollectionController::processRadixSort;
+				break;
+			case Gameplay::Collection::SortType::MULTIWAY_MERGE_SORT:
+				sort_function = &StickCollectionController::processMultiwayMergeSort;
 				break;
 			}
+
+			// Exported runs record on the calling thread, so the frames never depend on thread timing.
+			if (fixed_timestep)
+			{
+				processSortThread(sort_function);
+				playRecordedLog();
+				return;
+			}
+
+			// Low priority: a whole sort keeps its worker busy, shorter tasks queued meanwhile go first.
+			sort_thread_finished = false;
+			sort_task_pending = true;
+			ServiceLocator::getInstance()->getTaskService()->submit([this, sort_function]() { processSortThread(sort_function); }, Task::TaskPriority::LOW, &sort_task);
+		}
+
+		// Stick ids tag every key with its position at the start of the sort, so stability can be checked too.
+		void StickCollectionController::verifySort()
+		{
+			std::vector<int> output_keys;
+			std::vector<int> output_origins;
+			for (Stick* stick : sticks)
+			{
+				output_keys.push_back(stick->data);
+				output_origins.push_back(verification_start_positions[stick->id]);
+			}
+
+			sort_verification = SortVerifier::verifyTagged(verification_input_keys.data(), output_keys.data(), output_origins.data(), output_keys.size());
+			if (!sort_verification.isValid(isStableSortType(sort_type)))
+			{
+				std::string name = "Sort type " + std::to_string(static_cast<int>(sort_type));
+				SortVerifier::printFailures(sort_verification, name.c_str(), isStableSortType(sort_type));
+			}
 		}
 
-		bool StickCollectionController::isCollectionSorted()
+		bool StickCollectionController::isStableSortType(SortType sort_type)
 		{
-			for (int i = 1; i < sticks.size(); i++) if (sticks[i] < sticks[i - 1]) return false;
+			return sort_type != SortType::SELECTION_SORT && sort_type != SortType::QUICK_SORT;
+		}
+
+		bool StickCollectionController::isSorting()
+		{
+			return sort_state == SortState::SORTING;
+		}
+
+		// Must be set before initialize(), the stick sizes are derived from it.
+		void StickCollectionController::setCollectionBounds(sf::FloatRect bounds)
+		{
+			collection_model->setCollectionBounds(bounds);
+		}
+
+		// Draws the sticks through StickBarRenderer instead of one view each; needs initialize() to have run first.
+		// Stays off, with the views in use, if the shader cannot be compiled.
+		bool StickCollectionController::setShaderRendering(bool enabled)
+		{
+			delete (bar_renderer);
+			bar_renderer = nullptr;
+
+			if (enabled)
+			{
+				if (!StickBarRenderer::isAvailable())
+				{
+					fprintf(stderr, "Shaders are not available, drawing sticks one by one\n");
+					return false;
+				}
+
+				bar_renderer = new StickBarRenderer();
+				if (!bar_renderer->initialize(collection_model))
+				{
+					delete (bar_renderer);
+					bar_renderer = nullptr;
+					return false;
+				}
+
+				updateBars();
+			}
+			else
+			{
+				updateStickHeights();
+				for (int i = 0; i < display_sticks.size(); i++) setDisplayStickColor(i, display_sticks[i]->color);
+			}
+
+			updateStickPosition();
 			return true;
 		}
 
+		void StickCollectionController::setHighlightLifetime(int frames)
+		{
+			collection_model->highlight_lifetime_frames = std::max(0, frames);
+		}
+
+		void StickCollectionController::setSoundEnabled(bool enabled)
+		{
+			sound_enabled = enabled;
+		}
+
+		void StickCollectionController::setInputDistribution(InputDistribution distribution)
+		{
+			input_settings.distribution = distribution;
+		}
+
+		// A fixed seed makes every reset produce the same input, otherwise each reset draws a new one.
+		void StickCollectionController::setInputSeed(std::uint64_t seed)
+		{
+			input_settings.seed = seed;
+			randomize_input_seed = false;
+		}
+
+		const InputSettings& StickCollectionController::getInputSettings()
+		{
+			return input_settings;
+		}
+
+		// Keys must lie in [0, number of sticks); an empty list goes back to the generator.
+		void StickCollectionController::setInputKeys(const std::vector<int>& keys)
+		{
+			if (!keys.empty() && keys.size() != stick_pool.size()) return;
+			for (int key : keys) if (key < 0 || key >= stick_pool.size()) return;
+
+			input_keys = keys;
+		}
+
+		const std::vector<int>& StickCollectionController::getInputKeys()
+		{
+			return input_keys;
+		}
+
+		bool StickCollectionController::isRecording()
+		{
+			return sort_task_pending && !sort_thread_finished.load(std::memory_order_acquire);
+		}
+
+		std::int64_t StickCollectionController::getRecordedOperationCount() { return published_operation_count.load(std::memory_order_relaxed); }
+
+		long long StickCollectionController::getSortDurationMicroseconds() { return sort_duration_microseconds.load(std::memory_order_relaxed); }
+
+		const SortVerification& StickCollectionController::getSortVerification() { return sort_verification; }
+
 		void StickCollectionController::destroy()
 		{
 			current_operation_delay = 0;
-			if (sort_thread.joinable()) sort_thread.join();
-
-			for (int i = 0; i < sticks.size(); i++) delete(sticks[i]);
+			cancelSortThread();
+			ServiceLocator::getInstance()->getTaskService()->wait(input_task);
+			reset_pending = false;
+			stopPlayback();
+
+			recolored_sticks.clear();
+			for (int i = 0; i < stick_pool.size(); i++) delete(stick_pool[i]);
+			stick_pool.clear();
 			sticks.clear();
+			display_sticks.clear();
 
+			delete (bar_renderer);
+			bar_renderer = nullptr;
 			delete (collection_view);
 			delete (collection_model);
 		}
 
 		SortType StickCollectionController::getSortType() { return sort_type; }
 
-		int StickCollectionController::getNumberOfComparisons() { return number_of_comparisons; }
+		int StickCollectionController::getNumberOfComparisons() { return playback_comparisons; }
 
-		int StickCollectionController::getNumberOfArrayAccess() { return number_of_array_access; }
+		int StickCollectionController::getNumberOfArrayAccess() { return playback_array_access; }
 
 		int StickCollectionController::getNumberOfSticks() { return collection_model->number_of_elements; }
 
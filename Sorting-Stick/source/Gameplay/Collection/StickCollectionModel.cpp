@@ -22,5 +22,30 @@ namespace Gameplay {
 			elements_spacing = space;
 		}
 
+		void StickCollectionModel::setCollectionBounds(sf::FloatRect bounds)
+		{
+			collection_x_position = bounds.left;
+			collection_width = bounds.width;
+			max_element_height = bounds.height;
+			element_y_position = bounds.top + bounds.height;
+		}
+
+		sf::Color StickCollectionModel::getElementColor(ElementColor color)
+		{
+			switch (color)
+			{
+			case ElementColor::PROCESSING:
+				return processing_element_color;
+			case ElementColor::PLACEMENT_POSITION:
+				return placement_position_element_color;
+			case ElementColor::SELECTED:
+				return selected_element_color;
+			case ElementColor::TEMPORARY_PROCESSING:
+				return temporary_processing_color;
+			default:
+				return element_color;
+			}
+		}
+
 	}
 }
\ No newline at end of file
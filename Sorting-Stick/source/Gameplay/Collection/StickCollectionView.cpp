@@ -1,14 +1,20 @@
 #include "Gameplay/Collection/StickCollectionView.h"
+#include <algorithm>
 
 namespace Gameplay {
 	namespace Collection {
 
+		using namespace UI::UIElement;
+
 		StickCollectionView::StickCollectionView()
 		{
+			collection_controller = nullptr;
+			merge_tree_node_size = 0.f;
 		}
 
 		StickCollectionView::~StickCollectionView()
 		{
+			destroyMergeTree();
 		}
 
 		void StickCollectionView::initialize(StickCollectionController* collection_controller)
@@ -22,7 +28,90 @@ namespace Gameplay {
 
 		void StickCollectionView::render()
 		{
+			for (MergeTreeNode& node : merge_tree_nodes)
+			{
+				if (!node.visible) continue;
+
+				node.background->render();
+				node.key_bar->render();
+			}
+		}
+
+		// Node 0 holds the overall winner, node n (n >= 1) sits at depth log2(n) below it as in a binary heap.
+		void StickCollectionView::createMergeTree(int node_count, sf::FloatRect collection_bounds)
+		{
+			destroyMergeTree();
+			if (node_count <= 0) return;
+
+			int bottom_level_width = 1;
+			while (bottom_level_width * 2 <= std::max(1, node_count - 1)) bottom_level_width *= 2;
+
+			sf::FloatRect area;
+			area.width = collection_bounds.width * merge_tree_width_percentage;
+			area.left = collection_bounds.left + collection_bounds.width - area.width;
+			area.top = collection_bounds.top;
+
+			merge_tree_node_size = std::min(max_merge_tree_node_size, area.width / (bottom_level_width * 2));
+
+			for (int i = 0; i < node_count; i++)
+			{
+				MergeTreeNode node;
+				node.background = new RectangleShapeView();
+				node.key_bar = new RectangleShapeView();
+				node.position = getMergeTreeNodePosition(i, area);
+				node.visible = false;
+
+				node.background->initialize(sf::Vector2f(merge_tree_node_size, merge_tree_node_size), node.position, 0, merge_tree_node_color);
+				node.key_bar->initialize(sf::Vector2f(0, 0), node.position, 0, merge_tree_key_color);
+				merge_tree_nodes.push_back(node);
+			}
+		}
+
+		sf::Vector2f StickCollectionView::getMergeTreeNodePosition(int node, sf::FloatRect area)
+		{
+			float level_height = merge_tree_node_size * (1.f + merge_tree_level_spacing);
+			if (node == 0) return sf::Vector2f(area.left + (area.width - merge_tree_node_size) / 2.f, area.top);
+
+			int level = 0;
+			while ((2 << level) <= node) level++;
+
+			int level_width = 1 << level;
+			float slot_width = area.width / level_width;
+			float x_position = area.left + (node - level_width + 0.5f) * slot_width - merge_tree_node_size / 2.f;
+
+			return sf::Vector2f(x_position, area.top + (level + 1) * level_height);
+		}
+
+		void StickCollectionView::showMergeTreeNode(int node, float key_fraction, bool lit)
+		{
+			if (node < 0 || node >= merge_tree_nodes.size()) return;
+
+			MergeTreeNode& tree_node = merge_tree_nodes[node];
+			float bar_width = merge_tree_node_size * merge_tree_key_bar_width;
+			float bar_height = merge_tree_node_size * std::min(1.f, std::max(0.f, key_fraction));
+
+			tree_node.background->setFillColor(lit ? merge_tree_lit_node_color : merge_tree_node_color);
+			tree_node.key_bar->setSize(sf::Vector2f(bar_width, bar_height));
+			tree_node.key_bar->setPosition(sf::Vector2f(tree_node.position.x + (merge_tree_node_size - bar_width) / 2.f,
+				tree_node.position.y + merge_tree_node_size - bar_height));
+			tree_node.visible = true;
+		}
+
+		void StickCollectionView::hideMergeTreeNode(int node)
+		{
+			if (node < 0 || node >= merge_tree_nodes.size()) return;
+			merge_tree_nodes[node].visible = false;
+		}
+
+		void StickCollectionView::destroyMergeTree()
+		{
+			for (MergeTreeNode& node : merge_tree_nodes)
+			{
+				delete (node.background);
+				delete (node.key_bar);
+			}
+			merge_tree_nodes.clear();
 		}
 
 	}
-}
\ No newline at end of file
+}
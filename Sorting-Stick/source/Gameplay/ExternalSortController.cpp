@@ -0,0 +1,186 @@
+#include "Gameplay/ExternalSortController.h"
+#include <algorithm>
+#include <cstdio>
+#include "Global/ServiceLocator.h"
+
+namespace Gameplay
+{
+	using namespace Collection;
+	using namespace UI::UIElement;
+	using namespace Global;
+
+	ExternalSortController::ExternalSortController()
+	{
+		sorter = nullptr;
+		sort_thread_finished = true;
+		active = false;
+		input_row = BlockRow{ nullptr, nullptr, nullptr, 0.f, false };
+		output_row = BlockRow{ nullptr, nullptr, nullptr, 0.f, false };
+	}
+
+	ExternalSortController::~ExternalSortController()
+	{
+		stopSort();
+
+		destroyRow(input_row);
+		destroyRow(output_row);
+		for (BlockRow& row : run_rows) destroyRow(row);
+	}
+
+	void ExternalSortController::initialize()
+	{
+		createRow(input_row, input_row_y_position, done_block_color);
+		createRow(output_row, output_row_y_position, output_block_color);
+
+		run_rows.resize(max_visible_runs);
+		for (int i = 0; i < max_visible_runs; i++)
+		{
+			createRow(run_rows[i], first_run_row_y_position + i * (row_height + run_row_spacing), done_block_color);
+		}
+	}
+
+	void ExternalSortController::createRow(BlockRow& row, float y_position, sf::Color done_color)
+	{
+		row.background = new RectangleShapeView();
+		row.done_blocks = new RectangleShapeView();
+		row.active_block = new RectangleShapeView();
+		row.y_position = y_position;
+		row.visible = false;
+
+		row.background->initialize(sf::Vector2f(area_width, row_height), sf::Vector2f(area_x_position, y_position), 0, pending_block_color);
+		row.done_blocks->initialize(sf::Vector2f(0, row_height), sf::Vector2f(area_x_position, y_position), 0, done_color);
+		row.active_block->initialize(sf::Vector2f(0, row_height), sf::Vector2f(area_x_position, y_position), 0, active_block_color);
+	}
+
+	void ExternalSortController::destroyRow(BlockRow& row)
+	{
+		delete (row.background);
+		delete (row.done_blocks);
+		delete (row.active_block);
+		row = BlockRow{ nullptr, nullptr, nullptr, 0.f, false };
+	}
+
+	void ExternalSortController::update()
+	{
+		if (!active) return;
+
+		ExternalSortPhase previous_phase = progress.phase;
+		progress = sorter->getProgress();
+
+		// Progress moves on the worker; once the sort is over, only the final state needs drawing.
+		if (progress.phase == ExternalSortPhase::RUN_FORMATION || progress.phase == ExternalSortPhase::MERGE || progress.phase != previous_phase)
+			ServiceLocator::getInstance()->getGraphicService()->requestRedraw();
+
+		if (progress.merge_run_lengths.empty()) updateRunFormationRows();
+		else updateMergeRows();
+	}
+
+	void ExternalSortController::render()
+	{
+		if (!active) return;
+
+		renderRow(input_row);
+		for (BlockRow& row : run_rows) renderRow(row);
+		renderRow(output_row);
+	}
+
+	// The input is consumed one memory sized chunk at a time, the chunk being sorted is highlighted.
+	void ExternalSortController::updateRunFormationRows()
+	{
+		std::uint64_t active_elements = progress.phase == ExternalSortPhase::RUN_FORMATION ? progress.chunk_elements : 0;
+		updateRow(input_row, progress.elements_read, active_elements, progress.element_count, progress.chunk_elements);
+
+		for (BlockRow& row : run_rows) row.visible = false;
+		output_row.visible = false;
+	}
+
+	// Each run shows the blocks the loser tree has already taken and the block it is reading from.
+	void ExternalSortController::updateMergeRows()
+	{
+		updateRow(input_row, progress.element_count, 0, progress.element_count, progress.chunk_elements);
+
+		std::uint64_t group_elements = 0;
+		for (std::uint64_t length : progress.merge_run_lengths) group_elements += length;
+
+		for (int i = 0; i < run_rows.size(); i++)
+		{
+			if (i < progress.merge_run_lengths.size())
+			{
+				updateRow(run_rows[i], progress.merge_run_positions[i], progress.block_elements, progress.merge_run_lengths[i], progress.block_elements);
+			}
+			else run_rows[i].visible = false;
+		}
+
+		updateRow(output_row, progress.elements_written, progress.block_elements, group_elements, progress.block_elements);
+	}
+
+	// Widths are rounded down to whole blocks, which is the granularity the sort actually reads and writes at.
+	void ExternalSortController::updateRow(BlockRow& row, std::uint64_t done_elements, std::uint64_t active_elements, std::uint64_t total_elements, std::uint64_t block_elements)
+	{
+		row.visible = total_elements > 0;
+		if (!row.visible) return;
+
+		if (block_elements > 0 && done_elements < total_elements) done_elements -= done_elements % block_elements;
+		done_elements = std::min(done_elements, total_elements);
+		active_elements = std::min(active_elements, total_elements - done_elements);
+
+		float done_width = area_width * static_cast<float>(static_cast<double>(done_elements) / total_elements);
+		float active_width = area_width * static_cast<float>(static_cast<double>(active_elements) / total_elements);
+
+		row.done_blocks->setSize(sf::Vector2f(done_width, row_height));
+		row.active_block->setSize(sf::Vector2f(active_width, row_height));
+		row.active_block->setPosition(sf::Vector2f(area_x_position + done_width, row.y_position));
+	}
+
+	void ExternalSortController::renderRow(BlockRow& row)
+	{
+		if (!row.visible) return;
+
+		row.background->render();
+		row.done_blocks->render();
+		row.active_block->render();
+	}
+
+	void ExternalSortController::startSort(const std::string& input_path, const std::string& output_path, DatasetFormat format, std::size_t memory_budget)
+	{
+		stopSort();
+
+		active = true;
+		sorter = new ExternalSorter();
+		progress = ExternalSortProgress();
+		sort_thread_finished = false;
+		ServiceLocator::getInstance()->getTaskService()->submit([this, input_path, output_path, format, memory_budget]() {
+			if (sorter->sort(input_path, output_path, format, memory_budget))
+			{
+				ExternalSortProgress final_progress = sorter->getProgress();
+				fprintf(stderr, "Sorted %llu keys from %s in %.3f ms\n", static_cast<unsigned long long>(final_progress.element_count), input_path.c_str(), final_progress.duration_microseconds / 1000.0);
+			}
+			sort_thread_finished = true;
+		}, Task::TaskPriority::LOW, &sort_task);
+	}
+
+	void ExternalSortController::stopSort()
+	{
+		if (sorter) sorter->cancel();
+		ServiceLocator::getInstance()->getTaskService()->wait(sort_task);
+
+		delete (sorter);
+		sorter = nullptr;
+		active = false;
+	}
+
+	bool ExternalSortController::isActive()
+	{
+		return active;
+	}
+
+	bool ExternalSortController::isSorting()
+	{
+		return active && !sort_thread_finished;
+	}
+
+	const ExternalSortProgress& ExternalSortController::getProgress()
+	{
+		return progress;
+	}
+}
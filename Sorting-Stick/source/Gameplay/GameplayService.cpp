@@ -10,12 +10,18 @@ namespace Gameplay
 	{
 		gameplay_controller = new GameplayController();
 		collection_controller = new StickCollectionController();
+		race_controller = new RaceController();
+		external_sort_controller = new ExternalSortController();
+		dataset = nullptr;
 	}
 
 	GameplayService::~GameplayService()
 	{
 		delete (gameplay_controller);
 		delete (collection_controller);
+		delete (race_controller);
+		delete (external_sort_controller);
+		delete (dataset);
 	}
 
 	void GameplayService::initialize()
@@ -23,23 +29,32 @@ namespace Gameplay
 		std::srand(static_cast<unsigned int>(std::time(nullptr))); //set seed
 		gameplay_controller->initialize();
 		collection_controller->initialize();
+		external_sort_controller->initialize();
 	}
 
 	void GameplayService::update()
 	{
 		gameplay_controller->update();
-		collection_controller->update();
+
+		if (external_sort_controller->isActive()) external_sort_controller->update();
+		else if (race_controller->isRacing()) race_controller->update();
+		else collection_controller->update();
 	}
 
 	void GameplayService::render()
 	{
 		gameplay_controller->render();
-		collection_controller->render();
+
+		if (external_sort_controller->isActive()) external_sort_controller->render();
+		else if (race_controller->isRacing()) race_controller->render();
+		else collection_controller->render();
 	}
 
 	void GameplayService::reset()
 	{
 		gameplay_controller->reset();
+		race_controller->stopRace();
+		external_sort_controller->stopSort();
 		collection_controller->reset();
 	}
 
@@ -48,6 +63,170 @@ namespace Gameplay
 		collection_controller->sortElements(sort_type);
 	}
 
+	bool GameplayService::isSorting()
+	{
+		if (external_sort_controller->isActive()) return external_sort_controller->isSorting();
+		if (race_controller->isRacing()) return race_controller->isSorting();
+		return collection_controller->isSorting();
+	}
+
+	void GameplayService::startRace(const std::vector<Collection::SortType>& sort_types)
+	{
+		// The reset draws the race input, so the race starts from what the main collection would have shown.
+		collection_controller->reset();
+		race_controller->startRace(sort_types, collection_controller->getInputSettings(), collection_controller->getInputKeys());
+	}
+
+	bool GameplayService::isRacing()
+	{
+		return race_controller->isRacing();
+	}
+
+	RaceController* GameplayService::getRaceController()
+	{
+		return race_controller;
+	}
+
+	void GameplayService::startExternalSort(const std::string& input_path, const std::string& output_path, Collection::DatasetFormat format, std::size_t memory_budget)
+	{
+		race_controller->stopRace();
+		external_sort_controller->startSort(input_path, output_path, format, memory_budget);
+	}
+
+	ExternalSortController* GameplayService::getExternalSortController()
+	{
+		return external_sort_controller;
+	}
+
+	void GameplayService::setInputDistribution(Collection::InputDistribution distribution)
+	{
+		collection_controller->setInputDistribution(distribution);
+		collection_controller->reset();
+	}
+
+	Collection::InputDistribution GameplayService::getInputDistribution()
+	{
+		return collection_controller->getInputSettings().distribution;
+	}
+
+	void GameplayService::setInputSeed(std::uint64_t seed)
+	{
+		collection_controller->setInputSeed(seed);
+		collection_controller->reset();
+	}
+
+	// The whole dataset stays loaded for sortDataset(), the sticks show a downsample of it.
+	bool GameplayService::loadDataset(const std::string& path, Collection::DatasetFormat format, int csv_column)
+	{
+		Dataset* loaded_dataset = new Dataset();
+		if (!loaded_dataset->load(path, format, csv_column))
+		{
+			delete (loaded_dataset);
+			return false;
+		}
+
+		delete (dataset);
+		dataset = loaded_dataset;
+		fprintf(stderr, "Loaded %zu keys from %s\n", dataset->getKeyCount(), path.c_str());
+
+		collection_controller->setInputKeys(dataset->sampleKeys(collection_controller->getNumberOfSticks()));
+		collection_controller->reset();
+		return true;
+	}
+
+	bool GameplayService::sortDataset(const std::string& output_path)
+	{
+		if (!dataset) return false;
+
+		long long duration = dataset->sortKeys();
+		fprintf(stderr, "Sorted %zu keys in %.3f ms\n", dataset->getKeyCount(), duration / 1000.0);
+
+		const SortVerification& verification = dataset->getSortVerification();
+		if (!verification.isValid(false))
+		{
+			SortVerifier::printFailures(verification, "Dataset sort", false);
+			return false;
+		}
+
+		return output_path.empty() || dataset->saveKeys(output_path);
+	}
+
+	void GameplayService::setFixedTimestep(bool enabled)
+	{
+		collection_controller->setFixedTimestep(enabled);
+	}
+
+	void GameplayService::advanceSimulationTime(double milliseconds)
+	{
+		if (race_controller->isRacing()) race_controller->advanceSimulationTime(milliseconds);
+		else collection_controller->advanceSimulationTime(milliseconds);
+	}
+
+	bool GameplayService::setShaderStickRendering(bool enabled)
+	{
+		return collection_controller->setShaderRendering(enabled);
+	}
+
+	void GameplayService::setHighlightLifetime(int frames)
+	{
+		collection_controller->setHighlightLifetime(frames);
+	}
+
+	void GameplayService::setOperationLogRecordPath(const std::string& path)
+	{
+		collection_controller->setOperationLogRecordPath(path);
+	}
+
+	bool GameplayService::playOperationLog(const std::string& path, long long start_operation)
+	{
+		return collection_controller->playOperationLog(path, start_operation);
+	}
+
+	bool GameplayService::hasTimeline()
+	{
+		return collection_controller->hasTimeline();
+	}
+
+	void GameplayService::setPlaybackPaused(bool paused)
+	{
+		collection_controller->setPlaybackPaused(paused);
+	}
+
+	bool GameplayService::isPlaybackPaused()
+	{
+		return collection_controller->isPlaybackPaused();
+	}
+
+	void GameplayService::setPlaybackReversed(bool reversed)
+	{
+		collection_controller->setPlaybackReversed(reversed);
+	}
+
+	bool GameplayService::isPlaybackReversed()
+	{
+		return collection_controller->isPlaybackReversed();
+	}
+
+	void GameplayService::stepPlayback(bool forward)
+	{
+		collection_controller->stepPlayback(forward);
+	}
+
+	void GameplayService::seekPlayback(long long operation_index)
+	{
+		collection_controller->seekOperationLog(operation_index);
+	}
+
+	long long GameplayService::getPlaybackOperationIndex()
+	{
+		return collection_controller->getPlaybackOperationIndex();
+	}
+
+	long long GameplayService::getPlaybackOperationCount()
+	{
+		return collection_controller->getPlaybackOperationCount();
+	}
+
 	Collection::SortType GameplayService::getSortType()
 	{
 		return collection_controller->getSortType();
@@ -20,11 +20,11 @@ namespace Gameplay
 
 	void GameplayView::initializeBackgroundImage()
 	{
-		sf::RenderWindow* game_window = ServiceLocator::getInstance()->getGraphicService()->getGameWindow();
+		sf::Vector2f reference_resolution = ServiceLocator::getInstance()->getGraphicService()->getReferenceResolution();
 
 		background_image->initialize(Config::background_texture_path,
-			game_window->getSize().x,
-			game_window->getSize().y,
+			reference_resolution.x,
+			reference_resolution.y,
 			sf::Vector2f(0, 0));
 
 		background_image->setImageAlpha(background_alpha);
@@ -0,0 +1,102 @@
+#include "Gameplay/RaceController.h"
+#include "Gameplay/Collection/StickCollectionController.h"
+#include <algorithm>
+
+namespace Gameplay
+{
+	using namespace Collection;
+
+	RaceController::RaceController() = default;
+
+	RaceController::~RaceController()
+	{
+		stopRace();
+	}
+
+	void RaceController::update()
+	{
+		for (StickCollectionController* collection : race_collections) collection->update();
+	}
+
+	void RaceController::advanceSimulationTime(double milliseconds)
+	{
+		for (StickCollectionController* collection : race_collections) collection->advanceSimulationTime(milliseconds);
+	}
+
+	void RaceController::render()
+	{
+		for (StickCollectionController* collection : race_collections) collection->render();
+	}
+
+	// Every collection generates the same input from the shared seed (or takes the same fixed keys). The sorts run as tasks
+	// on the shared pool, whose workers each stay on a core of their own.
+	void RaceController::startRace(const std::vector<SortType>& sort_types, const InputSettings& input_settings, const std::vector<int>& input_keys)
+	{
+		stopRace();
+
+		for (int i = 0; i < sort_types.size(); i++)
+		{
+			StickCollectionController* collection = new StickCollectionController();
+			collection->setCollectionBounds(calculateCollectionBounds(i, static_cast<int>(sort_types.size())));
+			collection->setInputDistribution(input_settings.distribution);
+			collection->setInputSeed(input_settings.seed);
+			collection->setInputKeys(input_keys);
+			collection->initialize();
+			collection->setSoundEnabled(false);
+			race_collections.push_back(collection);
+		}
+
+		for (int i = 0; i < sort_types.size(); i++) race_collections[i]->sortElements(sort_types[i]);
+	}
+
+	void RaceController::stopRace()
+	{
+		for (StickCollectionController* collection : race_collections) delete (collection);
+		race_collections.clear();
+	}
+
+	bool RaceController::isRacing()
+	{
+		return !race_collections.empty();
+	}
+
+	bool RaceController::isSorting()
+	{
+		for (StickCollectionController* collection : race_collections) if (collection->isSorting()) return true;
+		return false;
+	}
+
+	int RaceController::getCollectionCount()
+	{
+		return static_cast<int>(race_collections.size());
+	}
+
+	StickCollectionController* RaceController::getCollection(int index)
+	{
+		return race_collections[index];
+	}
+
+	sf::FloatRect RaceController::getCellBounds(int index)
+	{
+		return calculateCellBounds(index, getCollectionCount());
+	}
+
+	sf::FloatRect RaceController::calculateCellBounds(int index, int count)
+	{
+		int columns = std::min(grid_columns, std::max(1, count));
+		int rows = (count + columns - 1) / columns;
+
+		float cell_width = grid_width / columns;
+		float cell_height = grid_height / std::max(1, rows);
+
+		return sf::FloatRect(grid_x_position + (index % columns) * cell_width, grid_y_position + (index / columns) * cell_height, cell_width, cell_height);
+	}
+
+	// The sticks fill the cell below its label area.
+	sf::FloatRect RaceController::calculateCollectionBounds(int index, int count)
+	{
+		sf::FloatRect cell = calculateCellBounds(index, count);
+
+		return sf::FloatRect(cell.left + cell_padding, cell.top + cell_label_height, cell.width - 2 * cell_padding, cell.height - cell_label_height - cell_padding);
+	}
+}
@@ -26,7 +26,8 @@ namespace Global
 
 	const sf::String Config::DS_DIGIB_font_path = "assets/fonts/DS_DIGIB.ttf";
 
-	const sf::String Config::compare_sfx_sound_path = "assets/sounds/compare_sfx.wav";
 
 	const sf::String Config::button_click_sound_path = "assets/sounds/button_click_sound.wav";
+
+	const sf::String Config::asset_pack_path = "assets/assets.pack";
 }
\ No newline at end of file
@@ -0,0 +1,205 @@
+#include "Global/MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Global
+{
+#ifdef _WIN32
+	MappedFile::MappedFile()
+	{
+		file_handle = INVALID_HANDLE_VALUE;
+		mapping_handle = nullptr;
+		data = nullptr;
+		size = 0;
+		writable = false;
+	}
+
+	bool MappedFile::openMapping(const std::string& path, MappedFileAccess access, bool copy_on_write)
+	{
+		close();
+
+		file_handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+			access == MappedFileAccess::SEQUENTIAL ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file_handle == INVALID_HANDLE_VALUE) return false;
+
+		LARGE_INTEGER file_size;
+		if (!GetFileSizeEx(file_handle, &file_size) || file_size.QuadPart == 0)
+		{
+			close();
+			return false;
+		}
+		size = static_cast<std::size_t>(file_size.QuadPart);
+
+		mapping_handle = CreateFileMappingA(file_handle, nullptr, copy_on_write ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, nullptr);
+		if (!mapping_handle)
+		{
+			close();
+			return false;
+		}
+
+		data = static_cast<const std::uint8_t*>(MapViewOfFile(mapping_handle, copy_on_write ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0));
+		if (!data)
+		{
+			close();
+			return false;
+		}
+
+		writable = copy_on_write;
+		return true;
+	}
+
+	bool MappedFile::create(const std::string& path, std::size_t file_size)
+	{
+		close();
+		if (file_size == 0) return false;
+
+		file_handle = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file_handle == INVALID_HANDLE_VALUE) return false;
+		size = file_size;
+
+		LARGE_INTEGER mapping_size;
+		mapping_size.QuadPart = static_cast<LONGLONG>(file_size);
+		mapping_handle = CreateFileMappingA(file_handle, nullptr, PAGE_READWRITE, mapping_size.HighPart, mapping_size.LowPart, nullptr);
+		if (!mapping_handle)
+		{
+			close();
+			return false;
+		}
+
+		data = static_cast<const std::uint8_t*>(MapViewOfFile(mapping_handle, FILE_MAP_WRITE, 0, 0, 0));
+		if (!data)
+		{
+			close();
+			return false;
+		}
+
+		writable = true;
+		return true;
+	}
+
+	bool MappedFile::flush()
+	{
+		if (!writable) return false;
+		return FlushViewOfFile(data, 0) != 0;
+	}
+
+	void MappedFile::close()
+	{
+		if (data) UnmapViewOfFile(data);
+		if (mapping_handle) CloseHandle(mapping_handle);
+		if (file_handle != INVALID_HANDLE_VALUE) CloseHandle(file_handle);
+
+		file_handle = INVALID_HANDLE_VALUE;
+		mapping_handle = nullptr;
+		data = nullptr;
+		size = 0;
+		writable = false;
+	}
+#else
+	MappedFile::MappedFile()
+	{
+		file_descriptor = -1;
+		data = nullptr;
+		size = 0;
+		writable = false;
+	}
+
+	bool MappedFile::openMapping(const std::string& path, MappedFileAccess access, bool copy_on_write)
+	{
+		close();
+
+		file_descriptor = ::open(path.c_str(), O_RDONLY);
+		if (file_descriptor < 0) return false;
+
+		struct stat file_status;
+		if (fstat(file_descriptor, &file_status) != 0 || file_status.st_size == 0)
+		{
+			close();
+			return false;
+		}
+		size = static_cast<std::size_t>(file_status.st_size);
+
+		void* mapping = mmap(nullptr, size, copy_on_write ? PROT_READ | PROT_WRITE : PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+		if (mapping == MAP_FAILED)
+		{
+			close();
+			return false;
+		}
+
+		if (access == MappedFileAccess::SEQUENTIAL) madvise(mapping, size, MADV_SEQUENTIAL);
+		data = static_cast<const std::uint8_t*>(mapping);
+		writable = copy_on_write;
+		return true;
+	}
+
+	bool MappedFile::create(const std::string& path, std::size_t file_size)
+	{
+		close();
+		if (file_size == 0) return false;
+
+		file_descriptor = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+		if (file_descriptor < 0) return false;
+
+		if (ftruncate(file_descriptor, static_cast<off_t>(file_size)) != 0)
+		{
+			close();
+			return false;
+		}
+		size = file_size;
+
+		void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0);
+		if (mapping == MAP_FAILED)
+		{
+			close();
+			return false;
+		}
+
+		data = static_cast<const std::uint8_t*>(mapping);
+		writable = true;
+		return true;
+	}
+
+	bool MappedFile::flush()
+	{
+		if (!writable) return false;
+		return msync(const_cast<std::uint8_t*>(data), size, MS_SYNC) == 0;
+	}
+
+	void MappedFile::close()
+	{
+		if (data) munmap(const_cast<std::uint8_t*>(data), size);
+		if (file_descriptor >= 0) ::close(file_descriptor);
+
+		file_descriptor = -1;
+		data = nullptr;
+		size = 0;
+		writable = false;
+	}
+#endif
+
+	MappedFile::~MappedFile()
+	{
+		close();
+	}
+
+	bool MappedFile::open(const std::string& path, MappedFileAccess access) { return openMapping(path, access, false); }
+
+	bool MappedFile::openCopyOnWrite(const std::string& path) { return openMapping(path, MappedFileAccess::NORMAL, true); }
+
+	bool MappedFile::isOpen() const { return data != nullptr; }
+
+	const std::uint8_t* MappedFile::getData() const { return data; }
+
+	std::uint8_t* MappedFile::getWritableData() { return writable ? const_cast<std::uint8_t*>(data) : nullptr; }
+
+	std::size_t MappedFile::getSize() const { return size; }
+}
@@ -9,6 +9,17 @@ namespace Global
 	using namespace UI;
 	using namespace Gameplay;
 	using namespace Main;
+	using namespace Task;
+	using namespace Asset;
+
+	namespace
+	{
+		// States in which the gameplay service runs and draws underneath the UI.
+		bool isGameplayState(GameState state)
+		{
+			return state == GameState::GAMEPLAY || state == GameState::RACE || state == GameState::EXTERNAL_SORT;
+		}
+	}
 
 	ServiceLocator::ServiceLocator()
 	{
@@ -17,6 +28,8 @@ namespace Global
 		sound_service = nullptr;
 		ui_service = nullptr;
 		gameplay_service = nullptr;
+		task_service = nullptr;
+		asset_service = nullptr;
 
 		createServices();
 	}
@@ -25,6 +38,8 @@ namespace Global
 
 	void ServiceLocator::createServices()
 	{
+		task_service = new TaskService();
+		asset_service = new AssetService();
 		event_service = new EventService();
 		graphic_service = new GraphicService();
 		sound_service = new SoundService();
@@ -32,9 +47,13 @@ namespace Global
 		gameplay_service = new GameplayService();
 	}
 
+	// The task pool starts first and stops last, every other service may hand it work. Assets start decoding on it
+	// as soon as the window exists and are shared by everything created after.
 	void ServiceLocator::initialize()
 	{
+		task_service->initialize();
 		graphic_service->initialize();
+		asset_service->initialize();
 		sound_service->initialize();
 		event_service->initialize();
 		ui_service->initialize();
@@ -44,8 +63,10 @@ namespace Global
 	void ServiceLocator::update()
 	{
 		graphic_service->update();
+		asset_service->update();
+		sound_service->update();
 		event_service->update();
-		if (GameService::getGameState() == GameState::GAMEPLAY)
+		if (isGameplayState(GameService::getGameState()))
 			gameplay_service->update();
 		ui_service->update();
 	}
@@ -53,7 +74,7 @@ namespace Global
 	void ServiceLocator::render()
 	{
 		graphic_service->render();
-		if (GameService::getGameState() == GameState::GAMEPLAY)
+		if (isGameplayState(GameService::getGameState()))
 			gameplay_service->render();
 		ui_service->render();
 	}
@@ -65,6 +86,8 @@ namespace Global
 		delete(sound_service);
 		delete(event_service);
 		delete(gameplay_service);
+		delete(asset_service);
+		delete(task_service);
 	}
 
 	ServiceLocator* ServiceLocator::getInstance()
@@ -83,5 +106,9 @@ namespace Global
 
 	GameplayService* ServiceLocator::getGameplayService() { return gameplay_service; }
 
+	TaskService* ServiceLocator::getTaskService() { return task_service; }
+
+	AssetService* ServiceLocator::getAssetService() { return asset_service; }
+
 	
 }
\ No newline at end of file
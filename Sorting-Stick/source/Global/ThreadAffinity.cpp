@@ -0,0 +1,37 @@
+#include "Global/ThreadAffinity.h"
+#include <algorithm>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace Global
+{
+	int ThreadAffinity::getCoreCount()
+	{
+		return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+	}
+
+	bool ThreadAffinity::pinToCore(std::thread& thread, int core)
+	{
+		if (!thread.joinable() || core < 0) return false;
+		core %= getCoreCount();
+
+#ifdef _WIN32
+		if (core >= static_cast<int>(sizeof(DWORD_PTR) * 8)) return false;
+		return SetThreadAffinityMask(static_cast<HANDLE>(thread.native_handle()), static_cast<DWORD_PTR>(1) << core) != 0;
+#elif defined(__linux__)
+		cpu_set_t core_set;
+		CPU_ZERO(&core_set);
+		CPU_SET(core, &core_set);
+		return pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &core_set) == 0;
+#else
+		return false;
+#endif
+	}
+}
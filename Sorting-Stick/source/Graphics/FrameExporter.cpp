@@ -0,0 +1,198 @@
+#include "Graphics/FrameExporter.h"
+#include <algorithm>
+#include "Global/ServiceLocator.h"
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace Graphics
+{
+	FrameExporter::FrameExporter()
+	{
+		export_format = FrameExportFormat::PNG_SEQUENCE;
+		raw_stream = nullptr;
+		next_frame_index = 0;
+		exported_frame_count = 0;
+		max_encoder_tasks = 0;
+		running_encoder_tasks = 0;
+		stopping = false;
+	}
+
+	FrameExporter::~FrameExporter()
+	{
+		finish();
+	}
+
+	bool FrameExporter::initialize(FrameExportFormat format, const std::string& path)
+	{
+		export_format = format;
+		output_path = path;
+
+		if (export_format == FrameExportFormat::RAW_STREAM)
+		{
+			if (!openRawStream()) return false;
+
+			// A raw stream has to stay in frame order, so a single writer handles it.
+			max_encoder_tasks = 1;
+		}
+		else
+		{
+			max_encoder_tasks = std::max(1, Global::ServiceLocator::getInstance()->getTaskService()->getWorkerCount());
+		}
+
+		stopping = false;
+
+		return true;
+	}
+
+	// "-" writes to stdout so the stream can be piped straight into an encoder. The frames get their own copy of
+	// the descriptor and stdout itself is pointed at stderr, so nothing printed afterwards lands in the pixel data.
+	bool FrameExporter::openRawStream()
+	{
+		if (output_path == "-")
+		{
+			std::fflush(stdout);
+#ifdef _WIN32
+			int frame_descriptor = _dup(_fileno(stdout));
+			if (frame_descriptor != -1)
+			{
+				_setmode(frame_descriptor, _O_BINARY);
+				raw_stream = _fdopen(frame_descriptor, "wb");
+				_dup2(_fileno(stderr), _fileno(stdout));
+			}
+#else
+			int frame_descriptor = dup(fileno(stdout));
+			if (frame_descriptor != -1)
+			{
+				raw_stream = fdopen(frame_descriptor, "wb");
+				dup2(fileno(stderr), fileno(stdout));
+			}
+#endif
+		}
+		else
+		{
+			raw_stream = std::fopen(output_path.c_str(), "wb");
+		}
+
+		if (!raw_stream)
+		{
+			fprintf(stderr, "Error opening raw frame stream %s\n", output_path.c_str());
+			return false;
+		}
+
+		return true;
+	}
+
+	// Blocks while the queue is full, so a slow disk or encoder slows the export down instead of dropping frames.
+	void FrameExporter::submitFrame(const sf::Image& frame_image)
+	{
+		if (max_encoder_tasks == 0 || stopping) return;
+
+		Frame frame;
+		frame.size = frame_image.getSize();
+		const sf::Uint8* pixels = frame_image.getPixelsPtr();
+		frame.pixels.assign(pixels, pixels + frame.size.x * frame.size.y * 4);
+
+		std::unique_lock<std::mutex> lock(frame_mutex);
+		size_t max_pending_frames = max_encoder_tasks * max_pending_frames_per_encoder;
+		frame_condition.wait(lock, [this, max_pending_frames] { return pending_frames.size() < max_pending_frames; });
+
+		frame.index = next_frame_index++;
+		pending_frames.push_back(std::move(frame));
+
+		if (running_encoder_tasks < max_encoder_tasks)
+		{
+			running_encoder_tasks++;
+			Global::ServiceLocator::getInstance()->getTaskService()->submit([this]() { processFrames(); });
+		}
+	}
+
+	// Runs as a task until the queue is empty, instead of blocking a pool worker while waiting for frames.
+	void FrameExporter::processFrames()
+	{
+		while (true)
+		{
+			Frame frame;
+			{
+				std::unique_lock<std::mutex> lock(frame_mutex);
+				if (pending_frames.empty())
+				{
+					running_encoder_tasks--;
+					frame_condition.notify_all();
+					return;
+				}
+
+				frame = std::move(pending_frames.front());
+				pending_frames.pop_front();
+				frame_condition.notify_all();
+			}
+
+			encodeFrame(frame);
+		}
+	}
+
+	void FrameExporter::encodeFrame(Frame& frame)
+	{
+		switch (export_format)
+		{
+		case FrameExportFormat::PNG_SEQUENCE:
+			writePngFrame(frame);
+			break;
+		case FrameExportFormat::RAW_STREAM:
+			writeRawFrame(frame);
+			break;
+		}
+
+		std::lock_guard<std::mutex> lock(frame_mutex);
+		exported_frame_count++;
+	}
+
+	void FrameExporter::writePngFrame(Frame& frame)
+	{
+		sf::Image image;
+		image.create(frame.size.x, frame.size.y, frame.pixels.data());
+
+		if (!image.saveToFile(getFramePath(frame.index)))
+			fprintf(stderr, "Error writing frame %d\n", frame.index);
+	}
+
+	// Tightly packed RGBA8, e.g. for ffmpeg -f rawvideo -pixel_format rgba -video_size 1920x1080.
+	void FrameExporter::writeRawFrame(Frame& frame)
+	{
+		if (std::fwrite(frame.pixels.data(), 1, frame.pixels.size(), raw_stream) != frame.pixels.size())
+			fprintf(stderr, "Error writing frame %d\n", frame.index);
+	}
+
+	std::string FrameExporter::getFramePath(int frame_index)
+	{
+		char file_name[32];
+		std::snprintf(file_name, sizeof(file_name), "frame_%06d.png", frame_index);
+		return output_path + "/" + file_name;
+	}
+
+	// Waits for the encoder tasks to drain the queue, so every submitted frame is on disk afterwards.
+	void FrameExporter::finish()
+	{
+		{
+			std::unique_lock<std::mutex> lock(frame_mutex);
+			stopping = true;
+			frame_condition.wait(lock, [this] { return running_encoder_tasks == 0; });
+		}
+
+		if (raw_stream)
+		{
+			std::fclose(raw_stream);
+			raw_stream = nullptr;
+		}
+	}
+
+	int FrameExporter::getExportedFrameCount()
+	{
+		std::lock_guard<std::mutex> lock(frame_mutex);
+		return exported_frame_count;
+	}
+}
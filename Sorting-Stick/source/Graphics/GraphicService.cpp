@@ -4,7 +4,15 @@ namespace Graphics
 {
 	GraphicService::GraphicService()
 	{
+		redraw_requested = true;
+		render_mode = RenderMode::WINDOWED;
+		frame_rate_limit = 60;
+		vertical_sync = false;
+		headless_running = false;
 		game_window = nullptr;
+		render_texture = nullptr;
+		render_target = nullptr;
+		frame_exporter = nullptr;
 	}
 
 	GraphicService::~GraphicService()
@@ -14,9 +22,22 @@ namespace Graphics
 
 	void GraphicService::initialize()
 	{
-		game_window = createGameWindow();
-		setFrameRate(frame_rate);
+		if (isHeadless())
+		{
+			render_texture = createRenderTexture();
+			render_target = render_texture;
+			headless_running = true;
+		}
+		else
+		{
+			game_window = createGameWindow();
+			if (render_mode == RenderMode::WINDOWED_OFFSCREEN) render_texture = createRenderTexture();
+			render_target = render_texture ? static_cast<sf::RenderTarget*>(render_texture) : game_window;
+			applyFramePacing();
+		}
+
 		setReferenceResolution();
+		applyReferenceView();
 	}
 
 	sf::RenderWindow* GraphicService::createGameWindow()
@@ -25,6 +46,17 @@ namespace Graphics
 		return new sf::RenderWindow(video_mode, game_window_title, sf::Style::Default);
 	}
 
+	// Offscreen target with the same size as the window, so layout code does not need to know the difference.
+	// Also drawn into when exporting from a window, the window then only shows the finished frame.
+	sf::RenderTexture* GraphicService::createRenderTexture()
+	{
+		sf::RenderTexture* texture = new sf::RenderTexture();
+		if (!texture->create(game_window_width, game_window_height))
+			fprintf(stderr, "Error creating headless render texture");
+
+		return texture;
+	}
+
 	void GraphicService::configureVideoMode()
 	{
 		video_mode = *(new sf::VideoMode(game_window_width, game_window_height, sf::VideoMode::getDesktopMode().bitsPerPixel));
@@ -35,6 +67,40 @@ namespace Graphics
 		reference_resolution = sf::Vector2f(game_window_width, game_window_height);
 	}
 
+	// The viewport is relative to the target, so the same view keeps filling the window after it is resized.
+	void GraphicService::applyReferenceView()
+	{
+		reference_view.reset(sf::FloatRect(0.f, 0.f, reference_resolution.x, reference_resolution.y));
+		render_target->setView(reference_view);
+		if (game_window) game_window->setView(reference_view);
+	}
+
+	// Everything is laid out in reference coordinates, so a resize only moves the view's viewport: the reference area
+	// is scaled to fit the new size and letterboxed, keeping its aspect ratio. No element or stick is touched.
+	// A DPI change reaches us as a resize of the framebuffer as well. An offscreen target keeps its size and view.
+	void GraphicService::onGameWindowResized(unsigned int width, unsigned int height)
+	{
+		if (width == 0 || height == 0) return;
+
+		float window_ratio = static_cast<float>(width) / height;
+		float reference_ratio = reference_resolution.x / reference_resolution.y;
+		sf::FloatRect viewport(0.f, 0.f, 1.f, 1.f);
+
+		if (window_ratio > reference_ratio)
+		{
+			viewport.width = reference_ratio / window_ratio;
+			viewport.left = (1.f - viewport.width) / 2.f;
+		}
+		else
+		{
+			viewport.height = window_ratio / reference_ratio;
+			viewport.top = (1.f - viewport.height) / 2.f;
+		}
+
+		reference_view.setViewport(viewport);
+		game_window->setView(reference_view);
+	}
+
 	sf::Vector2f GraphicService::getReferenceResolution()
 	{
 		return reference_resolution;
@@ -42,25 +108,139 @@ namespace Graphics
 
 	void GraphicService::onDestroy()
 	{
+		stopFrameExport();
 		delete(game_window);
+		delete(render_texture);
 	}
 
 	void GraphicService::setFrameRate(int frame_rate_to_set)
 	{
-		game_window->setFramerateLimit(frame_rate_to_set);
+		if (game_window) game_window->setFramerateLimit(frame_rate_to_set);
+	}
+
+	void GraphicService::setFramePacing(int frame_rate_limit_to_set, bool vertical_sync_to_set)
+	{
+		frame_rate_limit = frame_rate_limit_to_set;
+		vertical_sync = vertical_sync_to_set;
+		applyFramePacing();
+	}
+
+	// SFML advises against combining both, vsync wins.
+	void GraphicService::applyFramePacing()
+	{
+		if (!game_window) return;
+
+		game_window->setVerticalSyncEnabled(vertical_sync);
+		setFrameRate(vertical_sync ? 0 : frame_rate_limit);
+	}
+
+	void GraphicService::setRenderMode(RenderMode mode)
+	{
+		render_mode = mode;
+	}
+
+	bool GraphicService::isHeadless()
+	{
+		return render_mode == RenderMode::HEADLESS;
 	}
 
 	void GraphicService::update() { }
 
 	void GraphicService::render() { }
 
+	void GraphicService::display()
+	{
+		if (isHeadless()) render_texture->display();
+		else if (render_texture) presentRenderTexture();
+		else game_window->display();
+
+		if (frame_exporter) frame_exporter->submitFrame(captureFrame());
+
+		redraw_requested = false;
+		idle_clock.restart();
+	}
+
+	// The window's view maps the reference area onto its letterboxed viewport, so the frame is simply drawn at the origin.
+	void GraphicService::presentRenderTexture()
+	{
+		render_texture->display();
+
+		game_window->clear();
+		game_window->draw(sf::Sprite(render_texture->getTexture()));
+		game_window->display();
+	}
+
+	void GraphicService::requestRedraw() { redraw_requested = true; }
+
+	bool GraphicService::isRedrawNeeded()
+	{
+		return redraw_requested || isHeadless() || frame_exporter || idle_clock.getElapsedTime() >= idle_redraw_interval;
+	}
+
+	// Without display() nothing paces the loop any more, so a skipped frame sleeps for as long as a frame would take.
+	void GraphicService::skipFrame()
+	{
+		if (frame_rate_limit > 0 && !vertical_sync) sf::sleep(sf::seconds(1.f / frame_rate_limit));
+		else sf::sleep(uncapped_idle_frame_time);
+	}
+
 	bool GraphicService::isGameWindowOpen()
 	{
+		if (isHeadless()) return headless_running;
 		return game_window->isOpen();
 	}
 
+	void GraphicService::closeGameWindow()
+	{
+		if (isHeadless()) headless_running = false;
+		else game_window->close();
+	}
+
+	sf::Image GraphicService::captureFrame()
+	{
+		if (render_texture) return render_texture->getTexture().copyToImage();
+
+		sf::Texture window_texture;
+		window_texture.create(game_window->getSize().x, game_window->getSize().y);
+		window_texture.update(*game_window);
+		return window_texture.copyToImage();
+	}
+
+	// Every displayed frame is handed to the exporter, so the window should not wait for vsync meanwhile.
+	bool GraphicService::startFrameExport(FrameExportFormat format, const std::string& path)
+	{
+		stopFrameExport();
+
+		frame_exporter = new FrameExporter();
+		if (!frame_exporter->initialize(format, path))
+		{
+			stopFrameExport();
+			return false;
+		}
+
+		if (game_window) game_window->setVerticalSyncEnabled(false);
+		setFrameRate(0);
+		return true;
+	}
+
+	void GraphicService::stopFrameExport()
+	{
+		if (!frame_exporter) return;
+
+		frame_exporter->finish();
+		delete(frame_exporter);
+		frame_exporter = nullptr;
+
+		applyFramePacing();
+	}
+
 	sf::RenderWindow* GraphicService::getGameWindow()
 	{
 		return game_window;
 	}
-}
\ No newline at end of file
+
+	sf::RenderTarget* GraphicService::getRenderTarget()
+	{
+		return render_target;
+	}
+}
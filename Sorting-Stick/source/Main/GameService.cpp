@@ -2,6 +2,9 @@
 #include "Graphics/GraphicService.h"
 #include "Event/EventService.h"
 #include "UI/UIService.h"
+#include "Gameplay/GameplayService.h"
+#include "Gameplay/Collection/MergeBenchmark.h"
+#include <algorithm>
 
 namespace Main
 {
@@ -9,10 +12,17 @@ namespace Main
 	using namespace Graphics;
 	using namespace Event;
 	using namespace UI;
+	using namespace Gameplay::Collection;
 
 	GameState GameService::current_state = GameState::BOOT;
 
-	GameService::GameService() { service_locator = nullptr; }
+	GameService::GameService(LaunchOptions options)
+	{
+		launch_options = options;
+		service_locator = nullptr;
+		render_target = nullptr;
+		simulation_accumulator = 0;
+	}
 
 	GameService::~GameService() { destroy(); }
 
@@ -24,12 +34,44 @@ namespace Main
 
 	void GameService::initialize()
 	{
+		if (launch_options.headless) service_locator->getGraphicService()->setRenderMode(RenderMode::HEADLESS);
+		else if (launch_options.isExportingFrames()) service_locator->getGraphicService()->setRenderMode(RenderMode::WINDOWED_OFFSCREEN);
+		if (!launch_options.build_asset_pack_path.empty()) service_locator->getAssetService()->setAssetPackEnabled(false);
+		service_locator->getAssetService()->setAssetReportEnabled(launch_options.asset_report);
+		service_locator->getGraphicService()->setFramePacing(launch_options.frame_rate_limit, launch_options.vertical_sync);
+
 		service_locator->initialize();
 		initializeVariables();
-		showSplashScreen();
+
+		if (launch_options.shader_sticks) service_locator->getGameplayService()->setShaderStickRendering(true);
+		service_locator->getGameplayService()->setHighlightLifetime(launch_options.highlight_lifetime_frames);
+
+		service_locator->getGameplayService()->setInputDistribution(launch_options.input_distribution);
+		if (launch_options.fixed_input_seed) service_locator->getGameplayService()->setInputSeed(launch_options.input_seed);
+		if (!launch_options.dataset_path.empty() && !launch_options.external_sort) loadDataset();
+
+		if (launch_options.isExportingFrames()) startFrameExport();
+		if (!launch_options.record_log_path.empty()) service_locator->getGameplayService()->setOperationLogRecordPath(launch_options.record_log_path);
+
+		if (!launch_options.build_asset_pack_path.empty()) buildAssetPack();
+		else if (launch_options.benchmark_merge) runMergeBenchmark();
+		else if (!launch_options.play_log_path.empty()) startLogPlayback();
+		else if (launch_options.external_sort) startExternalSort();
+		else if (launch_options.race) startRace();
+		else if (launch_options.headless) startHeadlessSort();
+		else showSplashScreen();
 	}
 
-	void GameService::initializeVariables() { game_window = service_locator->getGraphicService()->getGameWindow(); }
+	void GameService::loadDataset()
+	{
+		Gameplay::GameplayService* gameplay_service = service_locator->getGameplayService();
+		if (!gameplay_service->loadDataset(launch_options.dataset_path, launch_options.dataset_format, launch_options.csv_column)) return;
+
+		// Timed on the full set before anything is shown, the sticks keep the unsorted downsample.
+		if (!launch_options.sorted_dataset_path.empty()) gameplay_service->sortDataset(launch_options.sorted_dataset_path);
+	}
+
+	void GameService::initializeVariables() { render_target = service_locator->getGraphicService()->getRenderTarget(); }
 
 	void GameService::showSplashScreen()
 	{
@@ -37,6 +79,91 @@ namespace Main
 		ServiceLocator::getInstance()->getUIService()->showScreen();
 	}
 
+	// Only the splash screen covers loading, every other start draws the full UI (or a screenshot) on its first frame.
+	void GameService::waitForAssets() { service_locator->getAssetService()->waitForAssets(); }
+
+	// Exported frames advance the sort by a fixed step each, independent of how long a frame takes to render and encode.
+	void GameService::startFrameExport()
+	{
+		bool started = launch_options.export_raw_path.empty()
+			? service_locator->getGraphicService()->startFrameExport(FrameExportFormat::PNG_SEQUENCE, launch_options.export_png_directory)
+			: service_locator->getGraphicService()->startFrameExport(FrameExportFormat::RAW_STREAM, launch_options.export_raw_path);
+
+		if (started) service_locator->getGameplayService()->setFixedTimestep(true);
+	}
+
+	// There is no menu to click through without a window, so go straight to the requested sort.
+	void GameService::startHeadlessSort()
+	{
+		waitForAssets();
+		setGameState(GameState::GAMEPLAY);
+		service_locator->getGameplayService()->sortElement(launch_options.sort_type);
+	}
+
+	// Races every sort type straight away; also used without a window, as there is no menu to click.
+	void GameService::startRace()
+	{
+		waitForAssets();
+		setGameState(GameState::RACE);
+		service_locator->getGameplayService()->startRace({ SortType::BUBBLE_SORT, SortType::INSERTION_SORT, SortType::SELECTION_SORT,
+			SortType::MERGE_SORT, SortType::QUICK_SORT, SortType::RADIX_SORT, SortType::MULTIWAY_MERGE_SORT });
+	}
+
+	// Sorts a dataset file too large for memory, showing its runs and merges instead of sticks.
+	void GameService::startExternalSort()
+	{
+		if (launch_options.dataset_path.empty() || launch_options.sorted_dataset_path.empty())
+		{
+			fprintf(stderr, "--external-sort needs --dataset and --save-sorted\n");
+			if (launch_options.headless) service_locator->getGraphicService()->closeGameWindow();
+			else showSplashScreen();
+			return;
+		}
+
+		waitForAssets();
+		setGameState(GameState::EXTERNAL_SORT);
+		service_locator->getGameplayService()->startExternalSort(launch_options.dataset_path, launch_options.sorted_dataset_path,
+			launch_options.dataset_format, launch_options.memory_budget_mb * 1024 * 1024);
+	}
+
+	// Nothing is drawn, the results go to stdout and the window is closed again.
+	void GameService::runMergeBenchmark()
+	{
+		MergeBenchmark::print(MergeBenchmark::run(launch_options.benchmark_key_count), launch_options.benchmark_key_count);
+		service_locator->getGraphicService()->closeGameWindow();
+	}
+
+	// The pack is written from the loose files, so it can be rebuilt over one that is already there.
+	void GameService::buildAssetPack()
+	{
+		Asset::AssetService::buildAssetPack(launch_options.build_asset_pack_path);
+		service_locator->getGraphicService()->closeGameWindow();
+	}
+
+	// Replays a recorded sort straight away; falls back to the normal start if the log cannot be read.
+	void GameService::startLogPlayback()
+	{
+		waitForAssets();
+		setGameState(GameState::GAMEPLAY);
+		if (service_locator->getGameplayService()->playOperationLog(launch_options.play_log_path, launch_options.play_log_start_operation)) return;
+
+		if (launch_options.headless) service_locator->getGraphicService()->closeGameWindow();
+		else showSplashScreen();
+	}
+
+	// Ends the headless run once the sort has finished and its final state has been rendered.
+	void GameService::processHeadlessState()
+	{
+		if (service_locator->getGameplayService()->isSorting()) return;
+
+		if (!launch_options.screenshot_path.empty() &&
+			!service_locator->getGraphicService()->captureFrame().saveToFile(launch_options.screenshot_path))
+			fprintf(stderr, "Error saving screenshot %s\n", launch_options.screenshot_path.c_str());
+
+		service_locator->getGraphicService()->stopFrameExport();
+		service_locator->getGraphicService()->closeGameWindow();
+	}
+
 	bool GameService::isRunning() { return service_locator->getGraphicService()->isGameWindowOpen(); }
 
 	// Main Game Loop.
@@ -45,15 +172,46 @@ namespace Main
 		// Process Events.
 		service_locator->getEventService()->processEvents();
 
+		advanceSimulation();
+
 		// Update Game Logic.
 		service_locator->update();
 	}
 
+	// Exports advance by exactly one frame of the output, otherwise the real frame time is spent in fixed steps and the
+	// remainder carried over. A long stall (a dragged window, a breakpoint) counts as at most max_frame_milliseconds.
+	void GameService::advanceSimulation()
+	{
+		double frame_milliseconds = std::min(frame_clock.restart().asMicroseconds() / 1000.0, max_frame_milliseconds);
+
+		if (launch_options.isExportingFrames())
+		{
+			service_locator->getGameplayService()->advanceSimulationTime(1000.0 / launch_options.export_frame_rate);
+			return;
+		}
+
+		simulation_accumulator += frame_milliseconds;
+		while (simulation_accumulator >= simulation_step_milliseconds)
+		{
+			service_locator->getGameplayService()->advanceSimulationTime(simulation_step_milliseconds);
+			simulation_accumulator -= simulation_step_milliseconds;
+		}
+	}
+
 	void GameService::render()
 	{
-		game_window->clear();
+		GraphicService* graphic_service = service_locator->getGraphicService();
+		if (!graphic_service->isRedrawNeeded())
+		{
+			graphic_service->skipFrame();
+			return;
+		}
+
+		render_target->clear();
 		service_locator->render();
-		game_window->display();
+		service_locator->getGraphicService()->display();
+
+		if (launch_options.headless) processHeadlessState();
 	}
 
 	void GameService::destroy() {  }
@@ -0,0 +1,166 @@
+#include "Main/LaunchOptions.h"
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+
+namespace Main
+{
+	using namespace Gameplay::Collection;
+
+	LaunchOptions LaunchOptions::parse(int argc, char* argv[])
+	{
+		LaunchOptions options;
+
+		for (int i = 1; i < argc; i++)
+		{
+			std::string argument = argv[i];
+			bool has_value = i + 1 < argc;
+
+			if (argument == "--headless")
+			{
+				options.headless = true;
+			}
+			else if (argument == "--sort" && has_value)
+			{
+				if (!parseSortType(argv[++i], options.sort_type))
+					fprintf(stderr, "Unknown sort type %s, using bubble sort\n", argv[i]);
+			}
+			else if (argument == "--race")
+			{
+				options.race = true;
+			}
+			else if (argument == "--input" && has_value)
+			{
+				if (!InputGenerator::parseDistribution(argv[++i], options.input_distribution))
+					fprintf(stderr, "Unknown input distribution %s, using shuffled\n", argv[i]);
+			}
+			else if (argument == "--seed" && has_value)
+			{
+				options.fixed_input_seed = true;
+				options.input_seed = std::strtoull(argv[++i], nullptr, 10);
+			}
+			else if (argument == "--dataset" && has_value)
+			{
+				options.dataset_path = argv[++i];
+			}
+			else if (argument == "--dataset-format" && has_value)
+			{
+				if (!Dataset::parseFormat(argv[++i], options.dataset_format))
+					fprintf(stderr, "Unknown dataset format %s, using int32\n", argv[i]);
+			}
+			else if (argument == "--csv-column" && has_value)
+			{
+				options.csv_column = std::max(0, std::atoi(argv[++i]));
+			}
+			else if (argument == "--save-sorted" && has_value)
+			{
+				options.sorted_dataset_path = argv[++i];
+			}
+			else if (argument == "--external-sort")
+			{
+				options.external_sort = true;
+			}
+			else if (argument == "--memory-budget" && has_value)
+			{
+				options.memory_budget_mb = static_cast<std::size_t>(std::max(1, std::atoi(argv[++i])));
+			}
+			else if (argument == "--benchmark-merge")
+			{
+				options.benchmark_merge = true;
+			}
+			else if (argument == "--benchmark-keys" && has_value)
+			{
+				options.benchmark_key_count = static_cast<std::size_t>(std::max(1LL, std::atoll(argv[++i])));
+			}
+			else if (argument == "--build-asset-pack" && has_value)
+			{
+				options.build_asset_pack_path = argv[++i];
+			}
+			else if (argument == "--asset-report")
+			{
+				options.asset_report = true;
+			}
+			else if (argument == "--shader-sticks")
+			{
+				options.shader_sticks = true;
+			}
+			else if (argument == "--highlight-frames" && has_value)
+			{
+				options.highlight_lifetime_frames = std::max(0, std::atoi(argv[++i]));
+			}
+			else if (argument == "--fps" && has_value)
+			{
+				options.frame_rate_limit = std::max(0, std::atoi(argv[++i]));
+			}
+			else if (argument == "--vsync")
+			{
+				options.vertical_sync = true;
+			}
+			else if (argument == "--screenshot" && has_value)
+			{
+				options.screenshot_path = argv[++i];
+			}
+			else if (argument == "--export-png" && has_value)
+			{
+				options.export_png_directory = argv[++i];
+			}
+			else if (argument == "--export-raw" && has_value)
+			{
+				options.export_raw_path = argv[++i];
+			}
+			else if (argument == "--export-fps" && has_value)
+			{
+				options.export_frame_rate = std::max(1, std::atoi(argv[++i]));
+			}
+			else if (argument == "--record-log" && has_value)
+			{
+				options.record_log_path = argv[++i];
+			}
+			else if (argument == "--play-log" && has_value)
+			{
+				options.play_log_path = argv[++i];
+			}
+			else if (argument == "--seek" && has_value)
+			{
+				options.play_log_start_operation = std::max(0LL, std::atoll(argv[++i]));
+			}
+			else
+			{
+				fprintf(stderr, "Unknown argument %s\n", argument.c_str());
+				printUsage();
+			}
+		}
+
+		return options;
+	}
+
+	bool LaunchOptions::isExportingFrames() const
+	{
+		return !export_png_directory.empty() || !export_raw_path.empty();
+	}
+
+	bool LaunchOptions::parseSortType(const std::string& name, SortType& sort_type)
+	{
+		if (name == "bubble") sort_type = SortType::BUBBLE_SORT;
+		else if (name == "insertion") sort_type = SortType::INSERTION_SORT;
+		else if (name == "selection") sort_type = SortType::SELECTION_SORT;
+		else if (name == "merge") sort_type = SortType::MERGE_SORT;
+		else if (name == "quick") sort_type = SortType::QUICK_SORT;
+		else if (name == "radix") sort_type = SortType::RADIX_SORT;
+		else if (name == "kway") sort_type = SortType::MULTIWAY_MERGE_SORT;
+		else return false;
+
+		return true;
+	}
+
+	void LaunchOptions::printUsage()
+	{
+		fprintf(stderr, "Usage: Sorting-Stick [--headless] [--sort bubble|insertion|selection|merge|quick|radix|kway | --race] [--screenshot file.png]\n"
+			"       [--input shuffled|uniform|zipfian|few-unique|nearly-sorted|reversed|sawtooth|organ-pipe|gaussian|adversarial] [--seed number]\n"
+			"       [--dataset file [--dataset-format int32|float32|csv] [--csv-column 0] [--save-sorted file]]\n"
+			"       [--external-sort --dataset file --save-sorted file [--memory-budget 256]]\n"
+			"       [--benchmark-merge [--benchmark-keys 16777216]] [--build-asset-pack assets/assets.pack] [--asset-report]\n"
+			"       [--shader-sticks] [--highlight-frames 0] [--fps 60 (0 for uncapped) | --vsync] [--export-png directory | --export-raw file|-] [--export-fps 60]\n"
+			"       [--record-log file | --play-log file [--seek operation]]\n");
+	}
+}
@@ -1,14 +1,50 @@
 #include "Sound/SoundService.h"
 #include "Global/Config.h"
+#include "Global/ServiceLocator.h"
 
 namespace Sound
 {
 	using namespace Global;
 
+	SoundService::SoundService()
+	{
+		for (int i = 0; i < sound_type_count; i++) sound_buffers[i].store(nullptr, std::memory_order_relaxed);
+		stopping = false;
+	}
+
+	SoundService::~SoundService() { destroy(); }
+
 	void SoundService::initialize()
 	{
+		// Build servers running headless usually have no audio device either.
+		muted = ServiceLocator::getInstance()->getGraphicService()->isHeadless();
+
 		loadBackgroundMusicFromFile();
 		loadSoundFromFile();
+
+		if (muted) return;
+
+		audio_thread = std::thread(&SoundService::runAudioThread, this);
+		tone_synthesizer.play();
+	}
+
+	// Hands buffers to the audio thread as they finish loading.
+	void SoundService::update()
+	{
+		resolveSoundBuffers();
+	}
+
+	void SoundService::destroy()
+	{
+		{
+			std::lock_guard<std::mutex> lock(audio_mutex);
+			stopping = true;
+		}
+		audio_condition.notify_all();
+		if (audio_thread.joinable()) audio_thread.join();
+
+		for (sf::Sound& voice : voices) voice.stop();
+		tone_synthesizer.stop();
 	}
 
 	void SoundService::loadBackgroundMusicFromFile()
@@ -16,31 +52,107 @@ namespace Sound
 		
 	}
 
+	// The buffers decode in the background, a sound requested before it is ready is skipped.
 	void SoundService::loadSoundFromFile()
 	{
-		if (!buffer_button_click.loadFromFile(Config::button_click_sound_path))
-			printf("Error loading background music file");
-		if (!buffer_compare_sfx.loadFromFile(Config::compare_sfx_sound_path)) {
-			printf("Error loading compare sfx file");
+		Asset::AssetService* asset_service = ServiceLocator::getInstance()->getAssetService();
+		asset_service->requestSound(getSoundPath(SoundType::BUTTON_CLICK));
+		resolveSoundBuffers();
+	}
+
+	void SoundService::resolveSoundBuffers()
+	{
+		for (int i = 0; i < sound_type_count; i++)
+		{
+			if (sound_buffers[i].load(std::memory_order_relaxed)) continue;
+
+			const sf::SoundBuffer* buffer = ServiceLocator::getInstance()->getAssetService()->getSound(getSoundPath(static_cast<SoundType>(i)));
+			if (buffer) sound_buffers[i].store(buffer, std::memory_order_release);
 		}
 	}
 
-	void SoundService::playSound(SoundType soundType)
+	const sf::String& SoundService::getSoundPath(SoundType sound_type)
 	{
-		switch (soundType)
+		switch (sound_type)
 		{
 		case SoundType::BUTTON_CLICK:
-			sound_effect.setBuffer(buffer_button_click);
-			break;
-		case SoundType::COMPARE_SFX:
-			sound_effect.setBuffer(buffer_compare_sfx);;
-			break;
 		default:
-			printf("Invalid sound type");
+			return Config::button_click_sound_path;
+		}
+	}
+
+	// Never blocks; when the queue is full the sound is dropped, the audio thread is behind anyway.
+	void SoundService::playSound(SoundType soundType)
+	{
+		if (muted) return;
+
+		if (soundType != SoundType::BUTTON_CLICK)
+		{
+			fprintf(stderr, "Invalid sound type");
 			return;
 		}
 
-		sound_effect.play();
+		command_queue.push(soundType);
+	}
+
+	// pitch in [0, 1], usually the height of the compared stick.
+	void SoundService::playTone(float pitch)
+	{
+		if (muted) return;
+		tone_synthesizer.queueTone(pitch);
+	}
+
+	void SoundService::runAudioThread()
+	{
+		std::unique_lock<std::mutex> lock(audio_mutex);
+		while (!stopping)
+		{
+			audio_condition.wait_for(lock, audio_tick);
+			processCommands();
+		}
+	}
+
+	// Requests that arrive within one retrigger interval of the last play of their type collapse into nothing.
+	void SoundService::processCommands()
+	{
+		bool requested[sound_type_count] = { false };
+
+		SoundType sound_type;
+		while (command_queue.pop(sound_type)) requested[static_cast<int>(sound_type)] = true;
+
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		for (int i = 0; i < sound_type_count; i++)
+		{
+			if (!requested[i] || now - last_play_times[i] < retrigger_intervals[i]) continue;
+
+			last_play_times[i] = now;
+			playVoice(static_cast<SoundType>(i));
+		}
+	}
+
+	void SoundService::playVoice(SoundType sound_type)
+	{
+		const sf::SoundBuffer* buffer = sound_buffers[static_cast<int>(sound_type)].load(std::memory_order_acquire);
+		if (!buffer) return;
+
+		sf::Sound& voice = getFreeVoice();
+		voice.setBuffer(*buffer);
+		voice.play();
+		voice_start_times[&voice - voices] = std::chrono::steady_clock::now();
+	}
+
+	// A voice that has finished, otherwise the one that has been playing longest.
+	sf::Sound& SoundService::getFreeVoice()
+	{
+		int oldest_voice = 0;
+		for (int i = 0; i < voice_count; i++)
+		{
+			if (voices[i].getStatus() == sf::SoundSource::Stopped) return voices[i];
+			if (voice_start_times[i] < voice_start_times[oldest_voice]) oldest_voice = i;
+		}
+
+		voices[oldest_voice].stop();
+		return voices[oldest_voice];
 	}
 
 	void SoundService::playBackgroundMusic()
@@ -49,4 +161,4 @@ namespace Sound
 		background_music.setVolume(background_music_volume);
 		background_music.play();
 	}
-}
\ No newline at end of file
+}
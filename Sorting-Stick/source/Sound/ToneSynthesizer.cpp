@@ -0,0 +1,98 @@
+#include "Sound/ToneSynthesizer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Sound
+{
+	namespace
+	{
+		const double two_pi = 6.283185307179586;
+	}
+
+	ToneSynthesizer::ToneSynthesizer()
+	{
+		chunk_samples.resize(chunk_sample_count);
+		tone_sample_count = static_cast<int>(tone_duration * sample_rate);
+		attack_sample_count = std::max(1, static_cast<int>(attack_duration * sample_rate));
+
+		initialize(1, sample_rate);
+	}
+
+	// SFML requires streams to stop their thread before the derived part is destroyed.
+	ToneSynthesizer::~ToneSynthesizer() { stop(); }
+
+	void ToneSynthesizer::queueTone(float pitch)
+	{
+		event_queue.push(pitch);
+	}
+
+	// Only the newest tones of the chunk are started, the rest of a burst would be inaudible under them anyway.
+	void ToneSynthesizer::startQueuedTones()
+	{
+		float newest_pitches[max_new_tones_per_chunk];
+		int queued_count = 0;
+
+		float pitch;
+		while (event_queue.pop(pitch)) newest_pitches[queued_count++ % max_new_tones_per_chunk] = pitch;
+
+		int start_count = std::min(queued_count, max_new_tones_per_chunk);
+		for (int i = 0; i < start_count; i++) startTone(newest_pitches[i]);
+	}
+
+	// Takes a silent voice, otherwise the one closest to its end.
+	void ToneSynthesizer::startTone(float pitch)
+	{
+		Tone* voice = &tones[0];
+		for (Tone& tone : tones)
+		{
+			if (tone.remaining_samples < voice->remaining_samples) voice = &tone;
+			if (voice->remaining_samples == 0) break;
+		}
+
+		pitch = std::min(1.f, std::max(0.f, pitch));
+		float frequency = min_frequency * std::pow(max_frequency / min_frequency, pitch);
+
+		voice->phase = 0.0;
+		voice->phase_increment = two_pi * frequency / sample_rate;
+		voice->amplitude = tone_amplitude;
+		voice->remaining_samples = tone_sample_count;
+	}
+
+	// Short linear attack against clicks, then a linear fade to silence over the rest of the tone.
+	float ToneSynthesizer::mixSample()
+	{
+		float mixed = 0.f;
+		for (Tone& tone : tones)
+		{
+			if (tone.remaining_samples == 0) continue;
+
+			int elapsed_samples = tone_sample_count - tone.remaining_samples;
+			float envelope = elapsed_samples < attack_sample_count
+				? static_cast<float>(elapsed_samples) / attack_sample_count
+				: static_cast<float>(tone.remaining_samples) / (tone_sample_count - attack_sample_count);
+
+			mixed += tone.amplitude * envelope * static_cast<float>(std::sin(tone.phase));
+			tone.phase += tone.phase_increment;
+			if (tone.phase >= two_pi) tone.phase -= two_pi;
+			tone.remaining_samples--;
+		}
+
+		// Soft clip, a burst of overlapping tones saturates instead of wrapping around.
+		return std::tanh(mixed);
+	}
+
+	bool ToneSynthesizer::onGetData(Chunk& data)
+	{
+		startQueuedTones();
+
+		for (int i = 0; i < chunk_sample_count; i++) chunk_samples[i] = static_cast<sf::Int16>(mixSample() * 32767.f);
+
+		data.samples = chunk_samples.data();
+		data.sampleCount = chunk_samples.size();
+		return true;
+	}
+
+	void ToneSynthesizer::onSeek(sf::Time /*time_offset*/)
+	{
+	}
+}
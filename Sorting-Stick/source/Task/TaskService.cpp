@@ -0,0 +1,277 @@
+#include "Task/TaskService.h"
+#include <algorithm>
+#include "Global/ThreadAffinity.h"
+
+namespace Task
+{
+	using namespace Global;
+
+	namespace
+	{
+		thread_local int current_worker_index = -1;
+
+		// Chunks of one parallelFor call; shared with its helper tasks, which may start after the call returned.
+		struct ParallelForState
+		{
+			const std::function<void(std::size_t, std::size_t)>* body;
+			std::size_t count;
+			std::size_t chunk_count;
+			std::atomic<std::size_t> next_chunk;
+			std::atomic<std::size_t> finished_chunks;
+			std::mutex state_mutex;
+			std::condition_variable finished_condition;
+
+			// Returns once no chunk is left to take.
+			void runChunks()
+			{
+				std::size_t chunk;
+				while ((chunk = next_chunk.fetch_add(1)) < chunk_count)
+				{
+					(*body)(count * chunk / chunk_count, count * (chunk + 1) / chunk_count);
+
+					if (finished_chunks.fetch_add(1) + 1 == chunk_count)
+					{
+						std::lock_guard<std::mutex> lock(state_mutex);
+						finished_condition.notify_all();
+					}
+				}
+			}
+		};
+	}
+
+	TaskGroup::TaskGroup()
+	{
+		pending_tasks = 0;
+	}
+
+	void TaskGroup::addTask()
+	{
+		pending_tasks.fetch_add(1);
+	}
+
+	// The mutex is held while notifying, so a waiter cannot return and destroy the group before this is done.
+	void TaskGroup::finishTask()
+	{
+		std::lock_guard<std::mutex> lock(group_mutex);
+		if (pending_tasks.fetch_sub(1) == 1) group_condition.notify_all();
+	}
+
+	bool TaskGroup::isIdle()
+	{
+		return pending_tasks.load() == 0;
+	}
+
+	TaskService::TaskService()
+	{
+		queued_task_count = 0;
+		stopping = false;
+	}
+
+	TaskService::~TaskService() { destroy(); }
+
+	// One worker per core except core 0, which is left to the main (and render) thread. Below min_worker_count + 1
+	// cores the workers do not all fit next to it, so none are pinned and the OS spreads them out.
+	void TaskService::initialize()
+	{
+		int core_count = ThreadAffinity::getCoreCount();
+		int worker_count = std::max(min_worker_count, core_count - 1);
+		bool pin_workers = worker_count < core_count;
+
+		stopping = false;
+		for (int i = 0; i < worker_count; i++) workers.emplace_back(new Worker());
+		for (int i = 0; i < worker_count; i++)
+		{
+			workers[i]->thread = std::thread(&TaskService::runWorker, this, i);
+			if (pin_workers) ThreadAffinity::pinToCore(workers[i]->thread, i + 1);
+		}
+	}
+
+	// Queued tasks still run before the workers exit.
+	void TaskService::destroy()
+	{
+		{
+			std::lock_guard<std::mutex> lock(shared_queue_mutex);
+			stopping = true;
+		}
+		work_condition.notify_all();
+
+		for (std::unique_ptr<Worker>& worker : workers)
+			if (worker->thread.joinable()) worker->thread.join();
+		workers.clear();
+	}
+
+	void TaskService::submit(std::function<void()> function, TaskPriority priority, TaskGroup* group)
+	{
+		if (group) group->addTask();
+
+		// Without workers (before initialize() or after destroy()) the task runs right away.
+		if (workers.empty())
+		{
+			QueuedTask task{ std::move(function), group };
+			executeTask(task);
+			return;
+		}
+
+		int worker_index = getCurrentWorkerIndex();
+		if (priority == TaskPriority::NORMAL && worker_index >= 0)
+		{
+			Worker& worker = *workers[worker_index];
+			std::lock_guard<std::mutex> lock(worker.queue_mutex);
+			worker.tasks.push_back(QueuedTask{ std::move(function), group });
+		}
+		else
+		{
+			std::lock_guard<std::mutex> lock(shared_queue_mutex);
+			shared_queues[static_cast<int>(priority)].push_back(QueuedTask{ std::move(function), group });
+		}
+
+		queued_task_count.fetch_add(1);
+		notifyWorkers();
+	}
+
+	// Taking the lock orders the notify after a worker that is about to sleep has checked queued_task_count.
+	void TaskService::notifyWorkers()
+	{
+		{
+			std::lock_guard<std::mutex> lock(shared_queue_mutex);
+		}
+		work_condition.notify_one();
+	}
+
+	void TaskService::runWorker(int worker_index)
+	{
+		current_worker_index = worker_index;
+
+		while (true)
+		{
+			QueuedTask task;
+			if (takeTask(worker_index, task))
+			{
+				executeTask(task);
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(shared_queue_mutex);
+			work_condition.wait(lock, [this] { return stopping || queued_task_count.load() > 0; });
+			if (stopping && queued_task_count.load() == 0) return;
+		}
+	}
+
+	// LOW tasks are whole sorts: a worker that only waits for something short must not pick one up.
+	bool TaskService::takeTask(int worker_index, QueuedTask& task, bool take_low_priority)
+	{
+		if (takeSharedTask(TaskPriority::HIGH, task)) return true;
+
+		if (worker_index >= 0)
+		{
+			Worker& worker = *workers[worker_index];
+			std::lock_guard<std::mutex> lock(worker.queue_mutex);
+			if (!worker.tasks.empty())
+			{
+				task = std::move(worker.tasks.back());
+				worker.tasks.pop_back();
+				queued_task_count.fetch_sub(1);
+				return true;
+			}
+		}
+
+		return takeSharedTask(TaskPriority::NORMAL, task) || stealTask(worker_index, task) || (take_low_priority && takeSharedTask(TaskPriority::LOW, task));
+	}
+
+	bool TaskService::takeSharedTask(TaskPriority priority, QueuedTask& task)
+	{
+		std::lock_guard<std::mutex> lock(shared_queue_mutex);
+
+		std::deque<QueuedTask>& queue = shared_queues[static_cast<int>(priority)];
+		if (queue.empty()) return false;
+
+		task = std::move(queue.front());
+		queue.pop_front();
+		queued_task_count.fetch_sub(1);
+		return true;
+	}
+
+	// Victims are tried starting after the thief, so idle workers spread over different deques.
+	bool TaskService::stealTask(int worker_index, QueuedTask& task)
+	{
+		int worker_count = static_cast<int>(workers.size());
+		for (int i = 1; i <= worker_count; i++)
+		{
+			int victim_index = (std::max(worker_index, 0) + i) % worker_count;
+			if (victim_index == worker_index) continue;
+
+			Worker& victim = *workers[victim_index];
+			std::lock_guard<std::mutex> lock(victim.queue_mutex);
+			if (victim.tasks.empty()) continue;
+
+			task = std::move(victim.tasks.front());
+			victim.tasks.pop_front();
+			queued_task_count.fetch_sub(1);
+			return true;
+		}
+
+		return false;
+	}
+
+	void TaskService::executeTask(QueuedTask& task)
+	{
+		task.function();
+		if (task.group) task.group->finishTask();
+	}
+
+	void TaskService::wait(TaskGroup& group)
+	{
+		int worker_index = getCurrentWorkerIndex();
+
+		if (worker_index >= 0)
+		{
+			while (!group.isIdle())
+			{
+				QueuedTask task;
+				if (takeTask(worker_index, task, false)) executeTask(task);
+				else std::this_thread::yield();
+			}
+		}
+
+		std::unique_lock<std::mutex> lock(group.group_mutex);
+		group.group_condition.wait(lock, [&group] { return group.isIdle(); });
+	}
+
+	void TaskService::parallelFor(std::size_t count, std::size_t min_chunk_size, const std::function<void(std::size_t, std::size_t)>& body)
+	{
+		if (count == 0) return;
+
+		std::size_t max_chunk_count = workers.size() * chunks_per_worker + 1;
+		std::size_t chunk_count = std::min(max_chunk_count, count / std::max<std::size_t>(min_chunk_size, 1));
+		if (chunk_count <= 1)
+		{
+			body(0, count);
+			return;
+		}
+
+		std::shared_ptr<ParallelForState> state = std::make_shared<ParallelForState>();
+		state->body = &body;
+		state->count = count;
+		state->chunk_count = chunk_count;
+		state->next_chunk = 0;
+		state->finished_chunks = 0;
+
+		std::size_t helper_count = std::min(workers.size(), chunk_count - 1);
+		for (std::size_t i = 0; i < helper_count; i++) submit([state]() { state->runChunks(); }, TaskPriority::HIGH);
+
+		state->runChunks();
+
+		std::unique_lock<std::mutex> lock(state->state_mutex);
+		state->finished_condition.wait(lock, [&state] { return state->finished_chunks.load() == state->chunk_count; });
+	}
+
+	int TaskService::getWorkerCount()
+	{
+		return static_cast<int>(workers.size());
+	}
+
+	int TaskService::getCurrentWorkerIndex()
+	{
+		return current_worker_index;
+	}
+}
@@ -0,0 +1,142 @@
+#include "UI/ExternalSortUI/ExternalSortUIController.h"
+#include "Global/Config.h"
+#include "Global/ServiceLocator.h"
+#include "Gameplay/GameplayService.h"
+#include "Gameplay/ExternalSortController.h"
+#include "Sound/SoundService.h"
+#include "Main/GameService.h"
+
+namespace UI
+{
+    namespace ExternalSortUI
+    {
+        using namespace Main;
+        using namespace Sound;
+        using namespace UIElement;
+        using namespace Global;
+        using namespace Gameplay;
+        using namespace Collection;
+
+        ExternalSortUIController::ExternalSortUIController()
+        {
+            createButton();
+            createTexts();
+        }
+
+        ExternalSortUIController::~ExternalSortUIController()
+        {
+            destroy();
+        }
+
+        void ExternalSortUIController::initialize()
+        {
+            initializeButton();
+            initializeTexts();
+        }
+
+        void ExternalSortUIController::createButton()
+        {
+            menu_button = new ButtonView();
+        }
+
+        void ExternalSortUIController::createTexts()
+        {
+            title_text = new TextView();
+            status_text = new TextView();
+            output_label_text = new TextView();
+        }
+
+        void ExternalSortUIController::initializeButton()
+        {
+            menu_button->initialize("Menu Button",
+                Config::menu_button_large_texture_path,
+                button_width, button_height,
+                sf::Vector2f(menu_button_x_position, menu_button_y_position));
+
+            registerButtonCallback();
+        }
+
+        void ExternalSortUIController::initializeTexts()
+        {
+            title_text->initialize("External Sort", sf::Vector2f(title_text_x_position, title_text_y_position), FontType::BUBBLE_BOBBLE, title_font_size);
+            status_text->initialize("", sf::Vector2f(status_text_x_position, status_text_y_position), FontType::BUBBLE_BOBBLE, status_font_size);
+            output_label_text->initialize("Output", sf::Vector2f(status_text_x_position, output_label_y_position), FontType::BUBBLE_BOBBLE, status_font_size);
+        }
+
+        void ExternalSortUIController::update()
+        {
+            menu_button->update();
+            title_text->update();
+            updateStatusText();
+            output_label_text->update();
+        }
+
+        void ExternalSortUIController::render()
+        {
+            menu_button->render();
+            title_text->render();
+            status_text->render();
+
+            if (!ServiceLocator::getInstance()->getGameplayService()->getExternalSortController()->getProgress().merge_run_lengths.empty())
+                output_label_text->render();
+        }
+
+        void ExternalSortUIController::show()
+        {
+            menu_button->show();
+            title_text->show();
+            status_text->show();
+            output_label_text->show();
+        }
+
+        void ExternalSortUIController::updateStatusText()
+        {
+            status_text->setText(getStatusString(ServiceLocator::getInstance()->getGameplayService()->getExternalSortController()->getProgress()));
+            status_text->update();
+        }
+
+        sf::String ExternalSortUIController::getStatusString(const ExternalSortProgress& progress)
+        {
+            switch (progress.phase)
+            {
+            case ExternalSortPhase::RUN_FORMATION:
+                return "Forming runs  :  " + std::to_string(progress.run_lengths.size()) + " runs    " +
+                    std::to_string(progress.elements_read) + " / " + std::to_string(progress.element_count) + " keys";
+
+            case ExternalSortPhase::MERGE:
+                return "Merge pass " + std::to_string(progress.merge_pass) + "  group " + std::to_string(progress.merge_group + 1) + " / " +
+                    std::to_string(progress.merge_group_count) + "  :  " + std::to_string(progress.merge_run_lengths.size()) + " runs    " +
+                    std::to_string(progress.elements_written) + " keys written";
+
+            case ExternalSortPhase::DONE:
+                return "Sorted " + std::to_string(progress.element_count) + " keys in " + std::to_string(progress.duration_microseconds / 1000) + " ms";
+
+            case ExternalSortPhase::FAILED:
+                return "External sort failed";
+
+            default:
+                return "Starting";
+            }
+        }
+
+        void ExternalSortUIController::menuButtonCallback()
+        {
+            ServiceLocator::getInstance()->getSoundService()->playSound(SoundType::BUTTON_CLICK);
+            ServiceLocator::getInstance()->getGameplayService()->reset();
+            GameService::setGameState(GameState::MAIN_MENU);
+        }
+
+        void ExternalSortUIController::registerButtonCallback()
+        {
+            menu_button->registerCallbackFuntion(std::bind(&ExternalSortUIController::menuButtonCallback, this));
+        }
+
+        void ExternalSortUIController::destroy()
+        {
+            delete (menu_button);
+            delete (title_text);
+            delete (status_text);
+            delete (output_label_text);
+        }
+    }
+}
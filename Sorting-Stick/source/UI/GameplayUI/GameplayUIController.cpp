@@ -5,6 +5,7 @@
 #include "Sound/SoundService.h"
 #include "Main/GameService.h"
 #include "Gameplay/Collection/StickCollectionModel.h"
+#include <cstdio>
 
 namespace UI
 {
@@ -19,8 +20,15 @@ namespace UI
 
         GameplayUIController::GameplayUIController()
         {
+            sort_type_shown = false;
+            shown_operation_index = -1;
+            shown_operation_count = -1;
+            shown_playback_reversed = false; // the labels the buttons are created with
+            shown_playback_paused = false;
+
             createButton();
             createTexts();
+            createTimelineControls();
         }
 
         GameplayUIController::~GameplayUIController()
@@ -32,6 +40,7 @@ namespace UI
         {
             initializeButton();
             initializeTexts();
+            initializeTimelineControls();
         }
 
         void GameplayUIController::createButton()
@@ -41,13 +50,17 @@ namespace UI
 
         void GameplayUIController::createTexts()
         {
-            search_type_text = new TextView();
-            comparisons_text = new TextView();
-            array_access_text = new TextView();
+            hud_texts = new TextBatchView();
+        }
 
-            num_sticks_text = new TextView();
-            delay_text = new TextView();
-            time_complexity_text = new TextView();
+        void GameplayUIController::createTimelineControls()
+        {
+            step_back_button = new TextButtonView();
+            reverse_button = new TextButtonView();
+            play_button = new TextButtonView();
+            step_forward_button = new TextButtonView();
+            timeline_slider = new SliderView();
+            timeline_texts = new TextBatchView();
         }
 
         void GameplayUIController::initializeButton()
@@ -62,17 +75,27 @@ namespace UI
 
         void GameplayUIController::initializeTexts()
         {
-            search_type_text->initialize("Sort Type  :  Bubble Sort", sf::Vector2f(search_type_text_x_position, text_y_position), FontType::BUBBLE_BOBBLE, font_size);
-            comparisons_text->initialize("Comparisons  :  0", sf::Vector2f(comparisons_text_x_position, text_y_position), FontType::BUBBLE_BOBBLE, font_size);
-            array_access_text->initialize("Array Access  :  0", sf::Vector2f(array_access_text_x_position, text_y_position), FontType::BUBBLE_BOBBLE, font_size);
-
-            num_sticks_text->initialize("Number of Sticks  :  0", sf::Vector2f(num_sticks_text_x_position, text_y_pos2), FontType::BUBBLE_BOBBLE, font_size);
+            hud_texts->initialize(FontType::BUBBLE_BOBBLE, font_size);
 
+            search_type_text = hud_texts->addText("Sort Type  :  Bubble Sort", sf::Vector2f(search_type_text_x_position, text_y_position));
+            comparisons_text = hud_texts->addText("Comparisons  :  0", sf::Vector2f(comparisons_text_x_position, text_y_position));
+            array_access_text = hud_texts->addText("Array Access  :  0", sf::Vector2f(array_access_text_x_position, text_y_position));
 
-            delay_text->initialize("Delay  :  0 ms", sf::Vector2f(delay_text_x_position, text_y_pos2), FontType::BUBBLE_BOBBLE, font_size);
-
+            num_sticks_text = hud_texts->addText("Number of Sticks  :  0", sf::Vector2f(num_sticks_text_x_position, text_y_pos2));
+            delay_text = hud_texts->addText("Delay  :  0 ms", sf::Vector2f(delay_text_x_position, text_y_pos2));
+            time_complexity_text = hud_texts->addText("Time Complexity  :  O(n)", sf::Vector2f(time_complexity_text_x_position, text_y_pos2));
+        }
 
-            time_complexity_text->initialize("Time Complexity  :  O(n)", sf::Vector2f(time_complexity_text_x_position, text_y_pos2), FontType::BUBBLE_BOBBLE, font_size);
+        void GameplayUIController::initializeTimelineControls()
+        {
+            step_back_button->initialize("<", sf::Vector2f(step_button_width, timeline_button_height), sf::Vector2f(step_back_button_x_position, timeline_y_position), timeline_font_size, timeline_button_color);
+            reverse_button->initialize("Reverse", sf::Vector2f(toggle_button_width, timeline_button_height), sf::Vector2f(reverse_button_x_position, timeline_y_position), timeline_font_size, timeline_button_color);
+            play_button->initialize("Pause", sf::Vector2f(play_button_width, timeline_button_height), sf::Vector2f(play_button_x_position, timeline_y_position), timeline_font_size, timeline_button_color);
+            step_forward_button->initialize(">", sf::Vector2f(step_button_width, timeline_button_height), sf::Vector2f(step_forward_button_x_position, timeline_y_position), timeline_font_size, timeline_button_color);
+
+            timeline_slider->initialize(sf::Vector2f(timeline_slider_width, timeline_slider_height), sf::Vector2f(timeline_slider_x_position, timeline_slider_y_position), timeline_track_color, timeline_fill_color);
+            timeline_texts->initialize(FontType::BUBBLE_BOBBLE, timeline_font_size);
+            timeline_text = timeline_texts->addText("0 / 0", sf::Vector2f(timeline_text_x_position, timeline_y_position));
         }
 
         void GameplayUIController::update()
@@ -84,109 +107,154 @@ namespace UI
 
             updateNumberOfSticksText();
             updateDelayText();
-            updateTimeComplexityText();
+            hud_texts->update();
+            updateTimelineControls();
         }
 
         void GameplayUIController::render()
         {
             menu_button->render();
-            search_type_text->render();
-            comparisons_text->render();
-            array_access_text->render();
-
-            num_sticks_text->render();
-            delay_text->render();
-            time_complexity_text->render();
+            hud_texts->render();
+
+            step_back_button->render();
+            reverse_button->render();
+            play_button->render();
+            step_forward_button->render();
+            timeline_slider->render();
+            timeline_texts->render();
         }
 
         void GameplayUIController::show()
         {
             menu_button->show();
-            search_type_text->show();
-            comparisons_text->show();
-            array_access_text->show();
-
-            num_sticks_text->show();
-            delay_text->show();
-            time_complexity_text->show();
+            hud_texts->show();
+
+            step_back_button->show();
+            reverse_button->show();
+            play_button->show();
+            step_forward_button->show();
+            timeline_slider->show();
+            timeline_texts->show();
         }
 
+        // The sort type and its complexity only change between sorts.
         void GameplayUIController::updateSearchTypeText()
         {
             SortType sort_type = ServiceLocator::getInstance()->getGameplayService()->getSortType();
+            if (sort_type_shown && sort_type == shown_sort_type) return;
 
             switch (sort_type)
             {
             case::Gameplay::SortType::BUBBLE_SORT:
-                search_type_text->setText("Bubble Sort");
+                hud_texts->setText(search_type_text, "Bubble Sort");
                 break;
 
             case::Gameplay::SortType::INSERTION_SORT:
-                search_type_text->setText("Insertion Sort");
+                hud_texts->setText(search_type_text, "Insertion Sort");
                 break;
 
             case::Gameplay::SortType::SELECTION_SORT:
-                search_type_text->setText("Selection Sort");
+                hud_texts->setText(search_type_text, "Selection Sort");
                 break;
 
             case::Gameplay::SortType::MERGE_SORT:
-                search_type_text->setText("Merge Sort");
+                hud_texts->setText(search_type_text, "Merge Sort");
                 break;
 
             case::Gameplay::SortType::QUICK_SORT:
-                search_type_text->setText("Quick Sort");
+                hud_texts->setText(search_type_text, "Quick Sort");
                 break;
 
             case::Gameplay::SortType::RADIX_SORT:
-                search_type_text->setText("Radix Sort");
+                hud_texts->setText(search_type_text, "Radix Sort");
+                break;
+
+            case::Gameplay::SortType::MULTIWAY_MERGE_SORT:
+                hud_texts->setText(search_type_text, "K-Way Merge Sort");
                 break;
             }
-            search_type_text->update();
+
+            updateTimeComplexityText();
+            shown_sort_type = sort_type;
+            sort_type_shown = true;
         }
 
         void GameplayUIController::updateComparisonsText()
         {
-            int comparisons = ServiceLocator::getInstance()->getGameplayService()->getNumberOfComparisons();;
-            sf::String comparisons_string = "Comparisons  :  " + std::to_string(comparisons);
-
-            comparisons_text->setText(comparisons_string);
-            comparisons_text->update();
+            int comparisons = ServiceLocator::getInstance()->getGameplayService()->getNumberOfComparisons();
+            hud_texts->setValue(comparisons_text, "Comparisons  :  ", comparisons);
         }
 
         void GameplayUIController::updateArrayAccessText()
         {
-            int array_access = ServiceLocator::getInstance()->getGameplayService()->getNumberOfArrayAccess();;
-            sf::String array_access_string = "Array Access  :  " + std::to_string(array_access);
-
-            array_access_text->setText(array_access_string);
-            array_access_text->update();
+            int array_access = ServiceLocator::getInstance()->getGameplayService()->getNumberOfArrayAccess();
+            hud_texts->setValue(array_access_text, "Array Access  :  ", array_access);
         }
 
         void GameplayUIController::updateNumberOfSticksText()
         {
             int num_sticks = ServiceLocator::getInstance()->getGameplayService()->getNumberOfSticks();
-            sf::String sticks_string = "Number of Sticks  :  " + std::to_string(num_sticks);
-
-            num_sticks_text->setText(sticks_string);
-            num_sticks_text->update();
+            hud_texts->setValue(num_sticks_text, "Number of Sticks  :  ", num_sticks);
         }
 
         void GameplayUIController::updateDelayText()
         {
             int delay_in_milliseconds = ServiceLocator::getInstance()->getGameplayService()->getDelayMilliseconds();
-            sf::String delay_string = "Delay (ms)  :  " + std::to_string(delay_in_milliseconds);
-
-            delay_text->setText(delay_string);
-            delay_text->update();
+            hud_texts->setValue(delay_text, "Delay (ms)  :  ", delay_in_milliseconds);
         }
 
         void GameplayUIController::updateTimeComplexityText()
         {
-            sf::String time_complexity = ServiceLocator::getInstance()->getGameplayService()->getTimeComplexity();
-            sf::String time_complexity_string = "Time Complexity  :  " + time_complexity;
+            std::string time_complexity = ServiceLocator::getInstance()->getGameplayService()->getTimeComplexity().toAnsiString();
+            std::string time_complexity_string = "Time Complexity  :  " + time_complexity;
+
+            hud_texts->setText(time_complexity_text, time_complexity_string.c_str());
+        }
+
+        // The timeline only accepts input once the sort has been recorded; while dragging, the slider owns its value.
+        void GameplayUIController::updateTimelineControls()
+        {
+            GameplayService* gameplay_service = ServiceLocator::getInstance()->getGameplayService();
+
+            if (gameplay_service->hasTimeline())
+            {
+                step_back_button->update();
+                reverse_button->update();
+                play_button->update();
+                step_forward_button->update();
+                timeline_slider->update();
+            }
+
+            long long operation_index = gameplay_service->getPlaybackOperationIndex();
+            long long operation_count = gameplay_service->getPlaybackOperationCount();
 
-            time_complexity_text->setText(time_complexity_string);
-            time_complexity_text->update();
+            if (!timeline_slider->isDragging())
+                timeline_slider->setValue(operation_count > 0 ? static_cast<float>(static_cast<double>(operation_index) / operation_count) : 0.f);
+
+            bool playback_reversed = gameplay_service->isPlaybackReversed();
+            if (playback_reversed != shown_playback_reversed)
+            {
+                reverse_button->setLabel(playback_reversed ? "Forward" : "Reverse");
+                shown_playback_reversed = playback_reversed;
+            }
+
+            bool playback_paused = gameplay_service->isPlaybackPaused();
+            if (playback_paused != shown_playback_paused)
+            {
+                play_button->setLabel(playback_paused ? "Play" : "Pause");
+                shown_playback_paused = playback_paused;
+            }
+
+            if (operation_index != shown_operation_index || operation_count != shown_operation_count)
+            {
+                char timeline_string[48];
+                std::snprintf(timeline_string, sizeof(timeline_string), "%lld / %lld", operation_index, operation_count);
+                timeline_texts->setText(timeline_text, timeline_string);
+
+                shown_operation_index = operation_index;
+                shown_operation_count = operation_count;
+            }
+            timeline_texts->update();
         }
 
         void GameplayUIController::menuButtonCallback()
@@ -196,20 +264,56 @@ namespace UI
             GameService::setGameState(GameState::MAIN_MENU);
         }
 
+        void GameplayUIController::stepBackButtonCallback()
+        {
+            ServiceLocator::getInstance()->getGameplayService()->stepPlayback(false);
+        }
+
+        void GameplayUIController::reverseButtonCallback()
+        {
+            GameplayService* gameplay_service = ServiceLocator::getInstance()->getGameplayService();
+            gameplay_service->setPlaybackReversed(!gameplay_service->isPlaybackReversed());
+        }
+
+        void GameplayUIController::playButtonCallback()
+        {
+            GameplayService* gameplay_service = ServiceLocator::getInstance()->getGameplayService();
+            gameplay_service->setPlaybackPaused(!gameplay_service->isPlaybackPaused());
+        }
+
+        void GameplayUIController::stepForwardButtonCallback()
+        {
+            ServiceLocator::getInstance()->getGameplayService()->stepPlayback(true);
+        }
+
+        void GameplayUIController::timelineSliderCallback(float value)
+        {
+            GameplayService* gameplay_service = ServiceLocator::getInstance()->getGameplayService();
+            gameplay_service->seekPlayback(static_cast<long long>(value * gameplay_service->getPlaybackOperationCount()));
+        }
+
         void GameplayUIController::registerButtonCallback()
         {
             menu_button->registerCallbackFuntion(std::bind(&GameplayUIController::menuButtonCallback, this));
+
+            step_back_button->registerCallbackFuntion(std::bind(&GameplayUIController::stepBackButtonCallback, this));
+            reverse_button->registerCallbackFuntion(std::bind(&GameplayUIController::reverseButtonCallback, this));
+            play_button->registerCallbackFuntion(std::bind(&GameplayUIController::playButtonCallback, this));
+            step_forward_button->registerCallbackFuntion(std::bind(&GameplayUIController::stepForwardButtonCallback, this));
+            timeline_slider->registerCallbackFuntion(std::bind(&GameplayUIController::timelineSliderCallback, this, std::placeholders::_1));
         }
 
         void GameplayUIController::destroy()
         {
             delete (menu_button);
-            delete (search_type_text);
-            delete (comparisons_text);
-            delete (array_access_text);
-            delete (num_sticks_text);
-            delete(delay_text);
-            delete(time_complexity_text);
+            delete (hud_texts);
+
+            delete (step_back_button);
+            delete (reverse_button);
+            delete (play_button);
+            delete (step_forward_button);
+            delete (timeline_slider);
+            delete (timeline_texts);
         }
     }
 }
\ No newline at end of file
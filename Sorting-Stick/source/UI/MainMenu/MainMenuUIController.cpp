@@ -48,6 +48,9 @@ namespace UI
             quick_sort_button = new ButtonView();
             radix_sort_button = new ButtonView();
             quit_button = new ButtonView();
+            race_button = new TextButtonView();
+            input_button = new TextButtonView();
+            multiway_merge_sort_button = new TextButtonView();
         }
 
         void MainMenuUIController::initializeBackgroundImage()
@@ -69,6 +72,10 @@ namespace UI
             quit_button->initialize("Quit Button", Config::quit_button_texture_path, button_width, button_height, sf::Vector2f(0, quit_button_y_position));
 
             quit_button->setCentreAlinged();
+
+            race_button->initialize("Race All", sf::Vector2f(race_button_width, race_button_height), sf::Vector2f(race_button_x_position, race_button_y_position), race_button_font_size, race_button_color);
+            input_button->initialize(getInputButtonLabel(), sf::Vector2f(input_button_width, input_button_height), sf::Vector2f(input_button_x_position, input_button_y_position), input_button_font_size, input_button_color);
+            multiway_merge_sort_button->initialize("K-Way Merge", sf::Vector2f(multiway_merge_sort_button_width, multiway_merge_sort_button_height), sf::Vector2f(multiway_merge_sort_button_x_position, multiway_merge_sort_button_y_position), multiway_merge_sort_button_font_size, multiway_merge_sort_button_color);
         }
 
         void MainMenuUIController::registerButtonCallback()
@@ -80,6 +87,9 @@ namespace UI
             quick_sort_button->registerCallbackFuntion(std::bind(&MainMenuUIController::quickSortButtonCallback, this));
             radix_sort_button->registerCallbackFuntion(std::bind(&MainMenuUIController::radixSortButtonCallback, this));
             quit_button->registerCallbackFuntion(std::bind(&MainMenuUIController::quitButtonCallback, this));
+            race_button->registerCallbackFuntion(std::bind(&MainMenuUIController::raceButtonCallback, this));
+            input_button->registerCallbackFuntion(std::bind(&MainMenuUIController::inputButtonCallback, this));
+            multiway_merge_sort_button->registerCallbackFuntion(std::bind(&MainMenuUIController::multiwayMergeSortButtonCallback, this));
         }
 
         void MainMenuUIController::bubbleSortButtonCallback()
@@ -124,9 +134,45 @@ namespace UI
             ServiceLocator::getInstance()->getGameplayService()->sortElement(Gameplay::Collection::SortType::RADIX_SORT);
         }
 
+        void MainMenuUIController::multiwayMergeSortButtonCallback()
+        {
+            ServiceLocator::getInstance()->getSoundService()->playSound(SoundType::BUTTON_CLICK);
+            GameService::setGameState(GameState::GAMEPLAY);
+            ServiceLocator::getInstance()->getGameplayService()->sortElement(Gameplay::Collection::SortType::MULTIWAY_MERGE_SORT);
+        }
+
+        void MainMenuUIController::raceButtonCallback()
+        {
+            ServiceLocator::getInstance()->getSoundService()->playSound(SoundType::BUTTON_CLICK);
+            GameService::setGameState(GameState::RACE);
+            ServiceLocator::getInstance()->getGameplayService()->startRace({
+                Gameplay::Collection::SortType::BUBBLE_SORT,
+                Gameplay::Collection::SortType::INSERTION_SORT,
+                Gameplay::Collection::SortType::SELECTION_SORT,
+                Gameplay::Collection::SortType::MERGE_SORT,
+                Gameplay::Collection::SortType::QUICK_SORT,
+                Gameplay::Collection::SortType::RADIX_SORT,
+                Gameplay::Collection::SortType::MULTIWAY_MERGE_SORT });
+        }
+
+        void MainMenuUIController::inputButtonCallback()
+        {
+            ServiceLocator::getInstance()->getSoundService()->playSound(SoundType::BUTTON_CLICK);
+
+            Gameplay::GameplayService* gameplay_service = ServiceLocator::getInstance()->getGameplayService();
+            gameplay_service->setInputDistribution(Gameplay::Collection::InputGenerator::getNextDistribution(gameplay_service->getInputDistribution()));
+            input_button->setLabel(getInputButtonLabel());
+        }
+
+        sf::String MainMenuUIController::getInputButtonLabel()
+        {
+            Gameplay::Collection::InputDistribution distribution = ServiceLocator::getInstance()->getGameplayService()->getInputDistribution();
+            return sf::String("Input: ") + Gameplay::Collection::InputGenerator::getDistributionName(distribution);
+        }
+
         void MainMenuUIController::quitButtonCallback()
         {
-            ServiceLocator::getInstance()->getGraphicService()->getGameWindow()->close();
+            ServiceLocator::getInstance()->getGraphicService()->closeGameWindow();
         }
 
         void MainMenuUIController::update()
@@ -139,6 +185,9 @@ namespace UI
             quick_sort_button->update();
             radix_sort_button->update();
             quit_button->update();
+            race_button->update();
+            input_button->update();
+            multiway_merge_sort_button->update();
         }
 
         void MainMenuUIController::render()
@@ -151,6 +200,9 @@ namespace UI
             quick_sort_button->render();
             radix_sort_button->render();
             quit_button->render();
+            race_button->render();
+            input_button->render();
+            multiway_merge_sort_button->render();
         }
 
         void MainMenuUIController::show()
@@ -163,6 +215,10 @@ namespace UI
             quick_sort_button->show();
             radix_sort_button->show();
             quit_button->show();
+            race_button->show();
+            input_button->setLabel(getInputButtonLabel());
+            input_button->show();
+            multiway_merge_sort_button->show();
         }
 
         void MainMenuUIController::destroy()
@@ -174,6 +230,9 @@ namespace UI
             delete (quick_sort_button);
             delete (radix_sort_button);
             delete (quit_button);
+            delete (race_button);
+            delete (input_button);
+            delete (multiway_merge_sort_button);
             delete (background_image);
         }
     }
@@ -0,0 +1,210 @@
+#include "UI/RaceUI/RaceUIController.h"
+#include "Global/Config.h"
+#include "Global/ServiceLocator.h"
+#include "Gameplay/GameplayService.h"
+#include "Gameplay/RaceController.h"
+#include "Gameplay/Collection/StickCollectionController.h"
+#include "Sound/SoundService.h"
+#include "Main/GameService.h"
+#include <algorithm>
+
+namespace UI
+{
+    namespace RaceUI
+    {
+        using namespace Main;
+        using namespace Sound;
+        using namespace UIElement;
+        using namespace Global;
+        using namespace Gameplay;
+        using namespace Collection;
+
+        RaceUIController::RaceUIController()
+        {
+            laid_out_cell_count = 0;
+            createButton();
+            createTexts();
+        }
+
+        RaceUIController::~RaceUIController()
+        {
+            destroy();
+        }
+
+        void RaceUIController::initialize()
+        {
+            initializeButton();
+            initializeTexts();
+        }
+
+        void RaceUIController::createButton()
+        {
+            menu_button = new ButtonView();
+        }
+
+        void RaceUIController::createTexts()
+        {
+            title_text = new TextView();
+
+            for (int i = 0; i < max_race_cells; i++)
+            {
+                name_texts.push_back(new TextView());
+                counter_texts.push_back(new TextView());
+            }
+        }
+
+        void RaceUIController::initializeButton()
+        {
+            menu_button->initialize("Menu Button",
+                Config::menu_button_large_texture_path,
+                button_width, button_height,
+                sf::Vector2f(menu_button_x_position, menu_button_y_position));
+
+            registerButtonCallback();
+        }
+
+        void RaceUIController::initializeTexts()
+        {
+            title_text->initialize("Sort Race", sf::Vector2f(title_text_x_position, title_text_y_position), FontType::BUBBLE_BOBBLE, title_font_size);
+
+            for (int i = 0; i < max_race_cells; i++)
+            {
+                name_texts[i]->initialize("", sf::Vector2f(0, 0), FontType::BUBBLE_BOBBLE, cell_font_size);
+                counter_texts[i]->initialize("", sf::Vector2f(0, 0), FontType::BUBBLE_BOBBLE, cell_font_size);
+            }
+            laid_out_cell_count = 0;
+        }
+
+        void RaceUIController::update()
+        {
+            menu_button->update();
+            title_text->update();
+            updateCellTexts();
+        }
+
+        void RaceUIController::render()
+        {
+            menu_button->render();
+            title_text->render();
+
+            int cell_count = std::min(max_race_cells, ServiceLocator::getInstance()->getGameplayService()->getRaceController()->getCollectionCount());
+            for (int i = 0; i < cell_count; i++)
+            {
+                name_texts[i]->render();
+                counter_texts[i]->render();
+            }
+        }
+
+        void RaceUIController::show()
+        {
+            menu_button->show();
+            title_text->show();
+
+            for (int i = 0; i < max_race_cells; i++)
+            {
+                name_texts[i]->show();
+                counter_texts[i]->show();
+            }
+        }
+
+        // While a sort thread is still running only its published operation count is shown,
+        // afterwards the replayed counters and the time the algorithm itself took.
+        void RaceUIController::updateCellTexts()
+        {
+            RaceController* race_controller = ServiceLocator::getInstance()->getGameplayService()->getRaceController();
+            int cell_count = std::min(max_race_cells, race_controller->getCollectionCount());
+
+            if (cell_count != laid_out_cell_count) layoutCellTexts(race_controller, cell_count);
+
+            for (int i = 0; i < cell_count; i++)
+            {
+                StickCollectionController* collection = race_controller->getCollection(i);
+                sf::String name_string = getSortTypeName(collection->getSortType());
+                sf::String counter_string;
+
+                if (collection->isRecording())
+                {
+                    counter_string = "Recording  :  " + std::to_string(collection->getRecordedOperationCount()) + " ops";
+                }
+                else
+                {
+                    name_string += "  (" + std::to_string(collection->getSortDurationMicroseconds()) + " us)";
+                    name_string += getVerificationLabel(collection->getSortVerification());
+                    counter_string = "Comparisons  :  " + std::to_string(collection->getNumberOfComparisons()) +
+                        "    Array Access  :  " + std::to_string(collection->getNumberOfArrayAccess());
+                }
+
+                name_texts[i]->setText(name_string);
+                counter_texts[i]->setText(counter_string);
+                name_texts[i]->update();
+                counter_texts[i]->update();
+            }
+        }
+
+        // The grid depends on how many sorts race, so the labels move whenever that changes.
+        void RaceUIController::layoutCellTexts(RaceController* race_controller, int cell_count)
+        {
+            for (int i = 0; i < cell_count; i++)
+            {
+                sf::FloatRect cell_bounds = race_controller->getCellBounds(i);
+
+                name_texts[i]->initialize("", sf::Vector2f(cell_bounds.left + cell_text_x_offset, cell_bounds.top + cell_name_text_y_offset), FontType::BUBBLE_BOBBLE, cell_font_size);
+                counter_texts[i]->initialize("", sf::Vector2f(cell_bounds.left + cell_text_x_offset, cell_bounds.top + cell_counter_text_y_offset), FontType::BUBBLE_BOBBLE, cell_font_size);
+            }
+
+            laid_out_cell_count = cell_count;
+        }
+
+        sf::String RaceUIController::getSortTypeName(SortType sort_type)
+        {
+            switch (sort_type)
+            {
+            case SortType::BUBBLE_SORT:
+                return "Bubble Sort";
+            case SortType::INSERTION_SORT:
+                return "Insertion Sort";
+            case SortType::SELECTION_SORT:
+                return "Selection Sort";
+            case SortType::MERGE_SORT:
+                return "Merge Sort";
+            case SortType::QUICK_SORT:
+                return "Quick Sort";
+            case SortType::RADIX_SORT:
+                return "Radix Sort";
+            case SortType::MULTIWAY_MERGE_SORT:
+                return "K-Way Merge Sort";
+            default:
+                return "";
+            }
+        }
+
+        // Every finished sort is checked for sortedness, lost or duplicated keys and the order of equal keys.
+        sf::String RaceUIController::getVerificationLabel(const SortVerification& verification)
+        {
+            if (!verification.stability_checked) return "";
+            if (!verification.sorted || !verification.permutation) return "  FAILED CHECK";
+            return verification.stable ? "  stable" : "  unstable";
+        }
+
+        void RaceUIController::menuButtonCallback()
+        {
+            ServiceLocator::getInstance()->getSoundService()->playSound(SoundType::BUTTON_CLICK);
+            ServiceLocator::getInstance()->getGameplayService()->reset();
+            GameService::setGameState(GameState::MAIN_MENU);
+        }
+
+        void RaceUIController::registerButtonCallback()
+        {
+            menu_button->registerCallbackFuntion(std::bind(&RaceUIController::menuButtonCallback, this));
+        }
+
+        void RaceUIController::destroy()
+        {
+            delete (menu_button);
+            delete (title_text);
+
+            for (TextView* text : name_texts) delete (text);
+            for (TextView* text : counter_texts) delete (text);
+        }
+    }
+}
@@ -14,30 +14,42 @@ namespace UI
         using namespace Global;
         using namespace UIElement;
         using namespace Sound;
+        using namespace Asset;
 
         SplashScreenUIController::SplashScreenUIController()
         {
             outscal_logo_view = new AnimatedImageView();
+            loading_bar_background = new RectangleShapeView();
+            loading_bar = new RectangleShapeView();
         }
 
         SplashScreenUIController::~SplashScreenUIController()
         {
             delete (outscal_logo_view);
+            delete (loading_bar_background);
+            delete (loading_bar);
         }
 
         void SplashScreenUIController::initialize()
         {
             initializeOutscalLogo();
+            initializeLoadingBar();
         }
 
         void SplashScreenUIController::update()
         {
             outscal_logo_view->update();
+            updateLoadingBar();
+
+            // The logo animates for as long as the splash screen is up.
+            ServiceLocator::getInstance()->getGraphicService()->requestRedraw();
         }
 
         void SplashScreenUIController::render()
         {
             outscal_logo_view->render();
+            loading_bar_background->render();
+            loading_bar->render();
         }
 
         void SplashScreenUIController::initializeOutscalLogo()
@@ -46,14 +58,42 @@ namespace UI
             outscal_logo_view->initialize(Config::outscal_logo_texture_path, logo_width, logo_height, position);
         }
 
+        void SplashScreenUIController::initializeLoadingBar()
+        {
+            sf::Vector2f position = getLogoPosition() + sf::Vector2f(0, logo_height + loading_bar_spacing);
+
+            loading_bar_background->initialize(sf::Vector2f(logo_width, loading_bar_height), position, 0, loading_bar_background_color);
+            loading_bar->initialize(sf::Vector2f(0, loading_bar_height), position, 0, loading_bar_color);
+        }
+
+        // Shown only while assets are still arriving.
+        void SplashScreenUIController::updateLoadingBar()
+        {
+            AssetService* asset_service = ServiceLocator::getInstance()->getAssetService();
+
+            if (asset_service->isLoading())
+            {
+                loading_bar_background->show();
+                loading_bar->show();
+                loading_bar->setSize(sf::Vector2f(logo_width * asset_service->getLoadingProgress(), loading_bar_height));
+            }
+            else
+            {
+                loading_bar_background->hide();
+                loading_bar->hide();
+            }
+        }
+
         void SplashScreenUIController::fadeInAnimationCallback()
         {
             outscal_logo_view->playAnimation(AnimationType::FADE_OUT, logo_animation_duration, std::bind(&SplashScreenUIController::fadeOutAnimationCallback, this));
         }
 
+        // Called every frame once the logo has faded out, the menu waits for its textures and fonts.
         void SplashScreenUIController::fadeOutAnimationCallback()
         {
-            
+            if (ServiceLocator::getInstance()->getAssetService()->isLoading()) return;
+
             GameService::setGameState(GameState::MAIN_MENU);
         }
 
@@ -10,14 +10,27 @@ namespace UI
         using namespace Event;
         using namespace Global;
 
-        ButtonView::ButtonView() = default;
+        ButtonView::ButtonView()
+        {
+            input_dispatcher = nullptr;
+            input_frame = 0;
+        }
 
-        ButtonView::~ButtonView() = default;
+        ButtonView::~ButtonView()
+        {
+            if (input_dispatcher) input_dispatcher->unregisterHandler(this);
+        }
 
         void ButtonView::initialize(sf::String title, sf::String texture_path, float button_width, float button_height, sf::Vector2f position)
         {
             ImageView::initialize(texture_path, button_width, button_height, position);
             button_title = title;
+
+            if (game_window)
+            {
+                input_dispatcher = ServiceLocator::getInstance()->getEventService()->getInputDispatcher();
+                input_dispatcher->registerHandler(this);
+            }
         }
 
         void ButtonView::registerCallbackFuntion(CallbackFunction button_callback)
@@ -28,11 +41,7 @@ namespace UI
         void ButtonView::update()
         {
             ImageView::update();
-
-            if (ui_state == UIState::VISIBLE)
-            {
-                handleButtonInteraction();
-            }
+            if (input_dispatcher) input_frame = input_dispatcher->getFrame();
         }
 
         void ButtonView::render()
@@ -40,25 +49,26 @@ namespace UI
             ImageView::render();
         }
 
-        void ButtonView::handleButtonInteraction()
+        bool ButtonView::isAcceptingInput()
         {
-            sf::Vector2f mouse_position = sf::Vector2f(sf::Mouse::getPosition(*game_window));
+            return ui_state == UIState::VISIBLE && texture_bound && input_frame == input_dispatcher->getFrame();
+        }
 
-            if (clickedButton(&image_sprite, mouse_position))
-            {
-                if (callback_function) callback_function();
-            }
+        sf::FloatRect ButtonView::getInputBounds() { return image_sprite.getGlobalBounds(); }
+
+        void ButtonView::onMousePressed(sf::Vector2f /*position*/)
+        {
+            if (callback_function) callback_function();
         }
 
-        bool ButtonView::clickedButton(sf::Sprite* button_sprite, sf::Vector2f mouse_position)
+        void ButtonView::onBoundsChanged()
         {
-            return ServiceLocator::getInstance()->getEventService()->pressedLeftMouseButton() &&
-                button_sprite->getGlobalBounds().contains(mouse_position);
+            if (input_dispatcher) input_dispatcher->invalidateBounds();
         }
 
         void ButtonView::printButtonClicked()
         {
-            printf("Clicked %s\n", button_title.toAnsiString().c_str());
+            fprintf(stderr, "Clicked %s\n", button_title.toAnsiString().c_str());
         }
     }
 }
\ No newline at end of file
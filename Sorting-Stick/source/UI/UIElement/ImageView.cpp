@@ -8,9 +8,17 @@ namespace UI
     {
         using namespace Global;
 
-        ImageView::ImageView() = default;
+        ImageView::ImageView()
+        {
+            texture_bound = false;
+            origin_at_centre = false;
+            centre_aligned = false;
+        }
 
-        ImageView::~ImageView() = default;
+        ImageView::~ImageView()
+        {
+            if (!image_texture_path.empty()) ServiceLocator::getInstance()->getAssetService()->releaseTexture(image_texture_path);
+        }
 
         void ImageView::initialize(sf::String texture_path, float image_width, float image_height, sf::Vector2f position)
         {
@@ -23,49 +31,78 @@ namespace UI
         void ImageView::update()
         {
             UIView::update();
+            if (!texture_bound) bindTexture();
         }
 
         void ImageView::render()
         {
             UIView::render();
 
-            if (ui_state == UIState::VISIBLE)
+            if (ui_state == UIState::VISIBLE && texture_bound)
             {
-                game_window->draw(image_sprite);
+                render_target->draw(image_sprite);
             }
         }
 
         void ImageView::setTexture(sf::String texture_path)
         {
-            if (image_texture.loadFromFile(texture_path))
-            {
-                image_sprite.setTexture(image_texture);
-            }
+            Asset::AssetService* asset_service = ServiceLocator::getInstance()->getAssetService();
+            asset_service->acquireTexture(texture_path);
+            if (!image_texture_path.empty()) asset_service->releaseTexture(image_texture_path);
+
+            image_texture_path = texture_path;
+            texture_bound = false;
+            bindTexture();
+        }
+
+        void ImageView::bindTexture()
+        {
+            if (image_texture_path.empty()) return;
+
+            const Asset::TextureRegion* region = ServiceLocator::getInstance()->getAssetService()->getTextureRegion(image_texture_path);
+            if (!region) return;
+
+            image_sprite.setTexture(*region->texture);
+            image_sprite.setTextureRect(region->rect);
+            texture_bound = true;
+
+            applyScale();
+            if (origin_at_centre) setOriginAtCentre();
+            if (centre_aligned) applyCentreAlignment();
         }
 
         void ImageView::setScale(float width, float height)
         {
-            sf::Vector2f adjusted_dimentions = getScaleForCurrentResolution(width, height);
+            image_size = sf::Vector2f(width, height);
+            if (texture_bound) applyScale();
+        }
 
-            float scale_x = adjusted_dimentions.x / image_sprite.getTexture()->getSize().x;
-            float scale_y = adjusted_dimentions.y / image_sprite.getTexture()->getSize().y;
+        void ImageView::applyScale()
+        {
+            float scale_x = image_size.x / image_sprite.getTextureRect().width;
+            float scale_y = image_size.y / image_sprite.getTextureRect().height;
 
             image_sprite.setScale(scale_x, scale_y);
+            onBoundsChanged();
         }
 
         void ImageView::setPosition(sf::Vector2f position)
         {
-            image_sprite.setPosition(getPositionForCurrentResolution(position));
+            image_sprite.setPosition(position);
+            onBoundsChanged();
         }
 
         void ImageView::setRotation(float rotation_angle)
         {
             image_sprite.setRotation(rotation_angle);
+            onBoundsChanged();
         }
 
         void ImageView::setOriginAtCentre()
         {
+            origin_at_centre = true;
             image_sprite.setOrigin(image_sprite.getLocalBounds().width / 2, image_sprite.getLocalBounds().height / 2);
+            onBoundsChanged();
         }
 
         void ImageView::setImageAlpha(float alpha)
@@ -77,10 +114,17 @@ namespace UI
 
         void ImageView::setCentreAlinged()
         {
-            float x_position = (game_window->getSize().x / 2) - (image_sprite.getGlobalBounds().width / 2);
+            centre_aligned = true;
+            if (texture_bound) applyCentreAlignment();
+        }
+
+        void ImageView::applyCentreAlignment()
+        {
+            float x_position = (reference_resolution.x / 2) - (image_sprite.getGlobalBounds().width / 2);
             float y_position = image_sprite.getGlobalBounds().getPosition().y;
 
             image_sprite.setPosition(x_position, y_position);
+            onBoundsChanged();
         }
     }
 }
\ No newline at end of file
@@ -30,20 +30,20 @@ namespace UI
 
 			if (ui_state == UIState::VISIBLE)
 			{
-				game_window->draw(rectangle_shape);
+				render_target->draw(rectangle_shape);
 			}
 		}
 
 		void RectangleShapeView::setSize(sf::Vector2f rectangle_size)
 		{
-			sf::Vector2f adjusted_dimentions = getScaleForCurrentResolution(rectangle_size.x, rectangle_size.y);
-
-			rectangle_shape.setSize(adjusted_dimentions);
+			rectangle_shape.setSize(rectangle_size);
+			onBoundsChanged();
 		}
 
 		void RectangleShapeView::setPosition(sf::Vector2f rectangle_position)
 		{
-			rectangle_shape.setPosition(getPositionForCurrentResolution(rectangle_position));
+			rectangle_shape.setPosition(rectangle_position);
+			onBoundsChanged();
 		}
 
 		void RectangleShapeView::setFillColor(sf::Color fill_color)
@@ -65,5 +65,10 @@ namespace UI
 		{
 			return rectangle_shape.getSize();
 		}
+
+		sf::FloatRect RectangleShapeView::getGlobalBounds()
+		{
+			return rectangle_shape.getGlobalBounds();
+		}
 	}
 }
\ No newline at end of file
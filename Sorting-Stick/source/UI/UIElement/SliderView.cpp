@@ -0,0 +1,118 @@
+#include "UI/UIElement/SliderView.h"
+#include "Global/ServiceLocator.h"
+#include "Event/EventService.h"
+#include <algorithm>
+
+namespace UI
+{
+	namespace UIElement
+	{
+		using namespace Global;
+
+		SliderView::SliderView()
+		{
+			fill_view = new RectangleShapeView();
+			value = 0;
+			dragging = false;
+			input_dispatcher = nullptr;
+			input_frame = 0;
+		}
+
+		SliderView::~SliderView()
+		{
+			if (input_dispatcher) input_dispatcher->unregisterHandler(this);
+			delete (fill_view);
+		}
+
+		void SliderView::initialize(sf::Vector2f size, sf::Vector2f position, sf::Color track_color, sf::Color fill_color)
+		{
+			slider_size = size;
+			slider_position = position;
+
+			RectangleShapeView::initialize(size, position, 0, track_color);
+			fill_view->initialize(sf::Vector2f(0, size.y), position, 0, fill_color);
+			setValue(0);
+
+			if (game_window)
+			{
+				input_dispatcher = ServiceLocator::getInstance()->getEventService()->getInputDispatcher();
+				input_dispatcher->registerHandler(this);
+			}
+		}
+
+		void SliderView::update()
+		{
+			RectangleShapeView::update();
+			fill_view->update();
+			if (input_dispatcher) input_frame = input_dispatcher->getFrame();
+		}
+
+		void SliderView::render()
+		{
+			RectangleShapeView::render();
+			fill_view->render();
+		}
+
+		void SliderView::show()
+		{
+			RectangleShapeView::show();
+			fill_view->show();
+		}
+
+		void SliderView::hide()
+		{
+			RectangleShapeView::hide();
+			fill_view->hide();
+		}
+
+		void SliderView::setValue(float new_value)
+		{
+			value = std::max(0.f, std::min(new_value, 1.f));
+			fill_view->setSize(sf::Vector2f(slider_size.x * value, slider_size.y));
+		}
+
+		float SliderView::getValue() { return value; }
+
+		bool SliderView::isDragging() { return dragging; }
+
+		void SliderView::registerCallbackFuntion(CallbackFunction slider_callback)
+		{
+			callback_function = slider_callback;
+		}
+
+		bool SliderView::isAcceptingInput()
+		{
+			return ui_state == UIState::VISIBLE && input_frame == input_dispatcher->getFrame();
+		}
+
+		sf::FloatRect SliderView::getInputBounds() { return getGlobalBounds(); }
+
+		// A drag starts with a click on the bar and follows the mouse until the button is released.
+		void SliderView::onMousePressed(sf::Vector2f position)
+		{
+			dragging = true;
+			dragTo(position);
+		}
+
+		void SliderView::onMouseDragged(sf::Vector2f position)
+		{
+			if (dragging) dragTo(position);
+		}
+
+		void SliderView::onMouseReleased(sf::Vector2f /*position*/) { dragging = false; }
+
+		void SliderView::dragTo(sf::Vector2f position)
+		{
+			sf::FloatRect bounds = getGlobalBounds();
+			if (bounds.width <= 0) return;
+
+			setValue((position.x - bounds.left) / bounds.width);
+			if (callback_function) callback_function(value);
+		}
+
+		void SliderView::onBoundsChanged()
+		{
+			if (input_dispatcher) input_dispatcher->invalidateBounds();
+		}
+	}
+}
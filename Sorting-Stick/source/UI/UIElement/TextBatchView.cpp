@@ -0,0 +1,150 @@
+#include "UI/UIElement/TextBatchView.h"
+#include "Global/ServiceLocator.h"
+#include <cstdio>
+#include <cstring>
+
+namespace UI
+{
+	namespace UIElement
+	{
+		using namespace Global;
+
+		TextBatchView::TextBatchView()
+		{
+			font = nullptr;
+			character_size = 0;
+			geometry_dirty = true;
+			font_texture = nullptr;
+			font_loaded = false;
+			vertices.setPrimitiveType(sf::Triangles);
+		}
+
+		TextBatchView::~TextBatchView() = default;
+
+		void TextBatchView::initialize(FontType font_type, int font_size, sf::Color color)
+		{
+			UIView::initialize();
+
+			font = TextView::getFont(font_type);
+			character_size = font_size;
+			text_color = color;
+		}
+
+		void TextBatchView::update()
+		{
+			UIView::update();
+
+			if (hasFontChanged()) geometry_dirty = true;
+			if (geometry_dirty)
+			{
+				rebuildGeometry();
+				ServiceLocator::getInstance()->getGraphicService()->requestRedraw();
+			}
+		}
+
+		void TextBatchView::render()
+		{
+			UIView::render();
+
+			if (ui_state == UIState::VISIBLE)
+			{
+				render_target->draw(vertices, sf::RenderStates(&font->getTexture(character_size)));
+			}
+		}
+
+		int TextBatchView::addText(const char* text, sf::Vector2f position)
+		{
+			BatchedText batched_text;
+			batched_text.position = position;
+			batched_text.value = 0;
+			batched_text.has_value = false;
+			std::snprintf(batched_text.text, sizeof(batched_text.text), "%s", text);
+
+			texts.push_back(batched_text);
+			geometry_dirty = true;
+			return static_cast<int>(texts.size()) - 1;
+		}
+
+		void TextBatchView::setText(int index, const char* text)
+		{
+			BatchedText& batched_text = texts[index];
+			batched_text.has_value = false;
+			if (std::strncmp(batched_text.text, text, max_text_length) == 0) return;
+
+			std::snprintf(batched_text.text, sizeof(batched_text.text), "%s", text);
+			geometry_dirty = true;
+		}
+
+		void TextBatchView::setValue(int index, const char* label, long long value)
+		{
+			BatchedText& batched_text = texts[index];
+			if (batched_text.has_value && batched_text.value == value) return;
+
+			batched_text.value = value;
+			batched_text.has_value = true;
+			std::snprintf(batched_text.text, sizeof(batched_text.text), "%s%lld", label, value);
+			geometry_dirty = true;
+		}
+
+		bool TextBatchView::hasFontChanged()
+		{
+			const sf::Texture* texture = &font->getTexture(character_size);
+			bool loaded = !font->getInfo().family.empty();
+			if (texture == font_texture && loaded == font_loaded) return false;
+
+			font_texture = texture;
+			font_loaded = loaded;
+			return true;
+		}
+
+		// clear() keeps the capacity of the vertex array, so rebuilding reuses the same memory every time.
+		void TextBatchView::rebuildGeometry()
+		{
+			vertices.clear();
+			for (const BatchedText& text : texts) appendText(text);
+			geometry_dirty = false;
+		}
+
+		// Same layout as sf::Text for a single line without styles: kerning, then one quad per glyph from the baseline.
+		void TextBatchView::appendText(const BatchedText& text)
+		{
+			sf::Vector2f origin = text.position;
+			float x = 0.f;
+			float y = static_cast<float>(character_size);
+			sf::Uint32 previous_character = 0;
+
+			for (const char* character = text.text; *character != '\0'; character++)
+			{
+				sf::Uint32 current_character = static_cast<unsigned char>(*character);
+				x += font->getKerning(previous_character, current_character, character_size);
+				previous_character = current_character;
+
+				const sf::Glyph& glyph = font->getGlyph(current_character, character_size, false);
+				if (current_character != ' ') appendGlyph(origin + sf::Vector2f(x, y), glyph);
+				x += glyph.advance;
+			}
+		}
+
+		void TextBatchView::appendGlyph(sf::Vector2f origin, const sf::Glyph& glyph)
+		{
+			const float padding = 1.f;
+
+			float left = origin.x + glyph.bounds.left - padding;
+			float top = origin.y + glyph.bounds.top - padding;
+			float right = origin.x + glyph.bounds.left + glyph.bounds.width + padding;
+			float bottom = origin.y + glyph.bounds.top + glyph.bounds.height + padding;
+
+			float u1 = static_cast<float>(glyph.textureRect.left) - padding;
+			float v1 = static_cast<float>(glyph.textureRect.top) - padding;
+			float u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width) + padding;
+			float v2 = static_cast<float>(glyph.textureRect.top + glyph.textureRect.height) + padding;
+
+			vertices.append(sf::Vertex(sf::Vector2f(left, top), text_color, sf::Vector2f(u1, v1)));
+			vertices.append(sf::Vertex(sf::Vector2f(right, top), text_color, sf::Vector2f(u2, v1)));
+			vertices.append(sf::Vertex(sf::Vector2f(left, bottom), text_color, sf::Vector2f(u1, v2)));
+			vertices.append(sf::Vertex(sf::Vector2f(left, bottom), text_color, sf::Vector2f(u1, v2)));
+			vertices.append(sf::Vertex(sf::Vector2f(right, top), text_color, sf::Vector2f(u2, v1)));
+			vertices.append(sf::Vertex(sf::Vector2f(right, bottom), text_color, sf::Vector2f(u2, v2)));
+		}
+	}
+}
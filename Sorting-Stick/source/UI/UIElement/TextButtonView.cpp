@@ -0,0 +1,88 @@
+#include "UI/UIElement/TextButtonView.h"
+#include "Global/ServiceLocator.h"
+#include "Event/EventService.h"
+
+namespace UI
+{
+	namespace UIElement
+	{
+		using namespace Global;
+
+		TextButtonView::TextButtonView()
+		{
+			label_text = new TextView();
+			input_dispatcher = nullptr;
+			input_frame = 0;
+		}
+
+		TextButtonView::~TextButtonView()
+		{
+			if (input_dispatcher) input_dispatcher->unregisterHandler(this);
+			delete (label_text);
+		}
+
+		void TextButtonView::initialize(sf::String label, sf::Vector2f button_size, sf::Vector2f position, int font_size, sf::Color fill_color)
+		{
+			RectangleShapeView::initialize(button_size, position, 0, fill_color);
+			label_text->initialize(label, sf::Vector2f(position.x + label_padding, position.y), FontType::BUBBLE_BOBBLE, font_size);
+
+			if (game_window)
+			{
+				input_dispatcher = ServiceLocator::getInstance()->getEventService()->getInputDispatcher();
+				input_dispatcher->registerHandler(this);
+			}
+		}
+
+		void TextButtonView::update()
+		{
+			RectangleShapeView::update();
+			label_text->update();
+			if (input_dispatcher) input_frame = input_dispatcher->getFrame();
+		}
+
+		void TextButtonView::render()
+		{
+			RectangleShapeView::render();
+			label_text->render();
+		}
+
+		void TextButtonView::show()
+		{
+			RectangleShapeView::show();
+			label_text->show();
+		}
+
+		void TextButtonView::hide()
+		{
+			RectangleShapeView::hide();
+			label_text->hide();
+		}
+
+		void TextButtonView::setLabel(sf::String label)
+		{
+			label_text->setText(label);
+		}
+
+		void TextButtonView::registerCallbackFuntion(CallbackFunction button_callback)
+		{
+			callback_function = button_callback;
+		}
+
+		bool TextButtonView::isAcceptingInput()
+		{
+			return ui_state == UIState::VISIBLE && input_frame == input_dispatcher->getFrame();
+		}
+
+		sf::FloatRect TextButtonView::getInputBounds() { return getGlobalBounds(); }
+
+		void TextButtonView::onMousePressed(sf::Vector2f /*position*/)
+		{
+			if (callback_function) callback_function();
+		}
+
+		void TextButtonView::onBoundsChanged()
+		{
+			if (input_dispatcher) input_dispatcher->invalidateBounds();
+		}
+	}
+}
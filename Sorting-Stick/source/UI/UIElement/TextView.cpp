@@ -1,5 +1,6 @@
 #include "UI/UIElement/TextView.h"
 #include "Global/Config.h"
+#include "Global/ServiceLocator.h"
 
 namespace UI
 {
@@ -7,9 +8,6 @@ namespace UI
 	{
 		using namespace Global;
 
-		sf::Font TextView::font_bubble_bobble;
-		sf::Font TextView::font_DS_DIGIB;
-
 		TextView::TextView() = default;
 
 		TextView::~TextView() = default;
@@ -36,36 +34,31 @@ namespace UI
 
 			if (ui_state == UIState::VISIBLE)
 			{
-				game_window->draw(text);
+				render_target->draw(text);
 			}
 		}
 
-		void TextView::initializeTextView()
+		void TextView::setText(sf::String text_value)
 		{
-			loadFont();
+			text.setString(text_value);
 		}
 
-		void TextView::loadFont()
+		void TextView::setFont(FontType font_type)
 		{
-			font_bubble_bobble.loadFromFile(Config::bubble_bobble_font_path);
-			font_DS_DIGIB.loadFromFile(Config::DS_DIGIB_font_path);
+			text.setFont(*getFont(font_type));
 		}
 
-		void TextView::setText(sf::String text_value)
+		const sf::Font* TextView::getFont(FontType font_type)
 		{
-			text.setString(text_value);
-		}
+			Asset::AssetService* asset_service = ServiceLocator::getInstance()->getAssetService();
 
-		void TextView::setFont(FontType font_type)
-		{
 			switch (font_type)
 			{
-			case FontType::BUBBLE_BOBBLE:
-				text.setFont(font_bubble_bobble);
-				break;
 			case FontType::DS_DIGIB:
-				text.setFont(font_DS_DIGIB);
-				break;
+				return asset_service->requestFont(Config::DS_DIGIB_font_path);
+			case FontType::BUBBLE_BOBBLE:
+			default:
+				return asset_service->requestFont(Config::bubble_bobble_font_path);
 			}
 		}
 
@@ -76,7 +69,7 @@ namespace UI
 
 		void TextView::setTextPosition(sf::Vector2f position)
 		{
-			text.setPosition(getPositionForCurrentResolution(position));
+			text.setPosition(position);
 		}
 
 		void TextView::setTextColor(sf::Color color)
@@ -86,7 +79,7 @@ namespace UI
 
 		void TextView::setTextCentreAligned()
 		{
-			float x_position = (game_window->getSize().x - text.getLocalBounds().width) / 2;
+			float x_position = (reference_resolution.x - text.getLocalBounds().width) / 2;
 			float y_position = text.getGlobalBounds().getPosition().y;
 
 			text.setPosition(sf::Vector2f(x_position, y_position));
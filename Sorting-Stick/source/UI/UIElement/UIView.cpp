@@ -16,6 +16,8 @@ namespace UI
 		void UIView::initialize()
 		{
 			game_window = ServiceLocator::getInstance()->getGraphicService()->getGameWindow();
+			render_target = ServiceLocator::getInstance()->getGraphicService()->getRenderTarget();
+			reference_resolution = ServiceLocator::getInstance()->getGraphicService()->getReferenceResolution();
 			ui_state = UIState::VISIBLE;
 		}
 
@@ -33,24 +35,6 @@ namespace UI
 			ui_state = UIState::HIDDEN;
 		}
 
-		sf::Vector2f UIView::getPositionForCurrentResolution(sf::Vector2f position)
-		{
-			sf::Vector2f reference_resolution = ServiceLocator::getInstance()->getGraphicService()->getReferenceResolution();
-
-			float adjusted_x_position = (position.x / reference_resolution.x) * game_window->getSize().x;
-			float adjusted_y_position = (position.y / reference_resolution.y) * game_window->getSize().y;
-
-			return sf::Vector2f(adjusted_x_position, adjusted_y_position);
-		}
-
-		sf::Vector2f UIView::getScaleForCurrentResolution(float width, float height)
-		{
-			sf::Vector2f reference_resolution = ServiceLocator::getInstance()->getGraphicService()->getReferenceResolution();
-
-			float adjusted_width = (width / reference_resolution.x) * game_window->getSize().x;
-			float adjusted_height = (height / reference_resolution.y) * game_window->getSize().y;
-
-			return sf::Vector2f(adjusted_width, adjusted_height);
-		}
+		void UIView::onBoundsChanged() { }
 	}
 }
\ No newline at end of file
@@ -1,6 +1,5 @@
 #include "UI/UIService.h"
 #include "Main/GameService.h"
-#include "UI/UIElement/TextView.h"
 
 namespace UI
 {
@@ -10,12 +9,16 @@ namespace UI
 	using namespace UIElement;
 	using namespace Interface;
 	using namespace GameplayUI;
+	using namespace RaceUI;
+	using namespace ExternalSortUI;
 
 	UIService::UIService()
 	{
 		splash_screen_controller = nullptr;
 		main_menu_controller = nullptr;
 		gameplay_controller = nullptr;
+		race_controller = nullptr;
+		external_sort_controller = nullptr;
 
 		createControllers();
 	}
@@ -25,6 +28,8 @@ namespace UI
 		splash_screen_controller = new SplashScreenUIController();
 		main_menu_controller = new MainMenuUIController();
 		gameplay_controller = new GameplayUIController();
+		race_controller = new RaceUIController();
+		external_sort_controller = new ExternalSortUIController();
 	}
 
 	UIService::~UIService()
@@ -34,7 +39,6 @@ namespace UI
 
 	void UIService::initialize()
 	{
-		TextView::initializeTextView();
 		initializeControllers();
 	}
 
@@ -61,6 +65,8 @@ namespace UI
 		splash_screen_controller->initialize();
 		main_menu_controller->initialize();
 		gameplay_controller->initialize();
+		race_controller->initialize();
+		external_sort_controller->initialize();
 	}
 
 	IUIController* UIService::getCurrentUIController()
@@ -76,6 +82,12 @@ namespace UI
 		case GameState::GAMEPLAY:
 			return gameplay_controller;
 
+		case GameState::RACE:
+			return race_controller;
+
+		case GameState::EXTERNAL_SORT:
+			return external_sort_controller;
+
 		default:
 			return nullptr;
 		}
@@ -86,5 +98,7 @@ namespace UI
 		delete(splash_screen_controller);
 		delete(main_menu_controller);
 		delete(gameplay_controller);
+		delete(race_controller);
+		delete(external_sort_controller);
 	}
 }
\ No newline at end of file